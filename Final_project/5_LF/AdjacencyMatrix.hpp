@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "EdgeList.hpp"
+
+// Read-only view of a dense adjacency matrix: row v holds, for every vertex u, the weight and ID
+// of the lightest edge between v and u, or NO_EDGE and -1 if there is none. An edge can weigh
+// NO_EDGE too, so only the ID tells whether there is an edge.
+struct AdjacencyMatrixView
+{
+    static constexpr Weight NO_EDGE = std::numeric_limits<Weight>::max();
+
+    const Weight *weights = nullptr; // vertexCount * vertexCount entries, row-major
+    const int *ids = nullptr;
+    int vertices = 0;
+
+    int vertexCount() const { return vertices; }
+    const Weight *weightRow(int v) const { return weights + static_cast<std::size_t>(v) * vertices; }
+    const int *idRow(int v) const { return ids + static_cast<std::size_t>(v) * vertices; }
+};
+
+// Owning dense adjacency matrix of an undirected graph, see AdjacencyMatrixView for the layout.
+// It takes O(V^2) memory, so it is only worth building for dense graphs.
+struct AdjacencyMatrix
+{
+    std::vector<Weight> weights;
+    std::vector<int> ids;
+    int vertices = 0;
+
+    AdjacencyMatrixView view() const
+    {
+        return AdjacencyMatrixView{weights.data(), ids.data(), vertices};
+    }
+
+    // Keeps the lightest of parallel edges; self-loops are left out
+    static AdjacencyMatrix build(const EdgeView &edges, int vertexCount)
+    {
+        AdjacencyMatrix matrix;
+        std::size_t n = vertexCount;
+        matrix.vertices = vertexCount;
+        matrix.weights.assign(n * n, AdjacencyMatrixView::NO_EDGE);
+        matrix.ids.assign(n * n, -1);
+        for (std::size_t i = 0; i < edges.size(); ++i)
+        {
+            std::size_t u = edges.from[i], v = edges.to[i];
+            if (u == v || (matrix.ids[u * n + v] >= 0 && !(edges.weight[i] < matrix.weights[u * n + v])))
+                continue;
+            matrix.weights[u * n + v] = matrix.weights[v * n + u] = edges.weight[i];
+            matrix.ids[u * n + v] = matrix.ids[v * n + u] = edges.id[i];
+        }
+        return matrix;
+    }
+};
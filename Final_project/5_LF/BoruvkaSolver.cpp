@@ -0,0 +1,127 @@
+#include "BoruvkaSolver.hpp"
+#include "Parallel.hpp"
+#include "ConcurrentUnionFind.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+EdgeList BoruvkaSolver::computeMSTEdges(const Graph &graph)
+{
+    EdgeView edges = graph.getEdges();
+    int vertexCount = graph.getVertexCount();
+    unsigned threadCount = threads ? threads : threadCountFor(edges.size());
+
+    // Strict order on the edges: by weight, then by position. Every component then has a single
+    // lightest edge, and the edges picked in a round cannot form a cycle.
+    auto lighter = [&edges](int a, int b)
+    {
+        return edges.weight[a] < edges.weight[b] || (edges.weight[a] == edges.weight[b] && a < b);
+    };
+
+    uf.reset(vertexCount);
+    component.resize(vertexCount);
+    std::iota(component.begin(), component.end(), 0);
+    if (vertexCount > bestCapacity)
+    {
+        best.reset(new std::atomic<int>[vertexCount]);
+        bestCapacity = vertexCount;
+    }
+
+    // Every thread keeps the edges of its range that still join two different components
+    activeEdges.resize(threadCount);
+    parallelFor(edges.size(), threadCount, [&](std::size_t begin, std::size_t end, unsigned t)
+                {
+        activeEdges[t].clear();
+        activeEdges[t].reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i)
+            if (edges.from[i] != edges.to[i])
+                activeEdges[t].push_back(static_cast<int>(i)); });
+
+    components.resize(vertexCount);
+    std::iota(components.begin(), components.end(), 0);
+    picked.resize(threadCount);
+    survivors.resize(threadCount);
+    mstEdges.clear();
+
+    while (!components.empty())
+    {
+        parallelFor(components.size(), threadCount, [&](std::size_t begin, std::size_t end, unsigned)
+                    {
+            for (std::size_t k = begin; k < end; ++k)
+                best[components[k]].store(-1, std::memory_order_relaxed); });
+
+        // Step 1: drop the edges inside a component and offer the others to both of their components
+        parallelFor(threadCount, threadCount, [&](std::size_t, std::size_t, unsigned t)
+                    {
+            auto offer = [&](int c, int e)
+            {
+                int current = best[c].load(std::memory_order_relaxed);
+                while ((current < 0 || lighter(e, current)) &&
+                       !best[c].compare_exchange_weak(current, e, std::memory_order_relaxed))
+                {
+                }
+            };
+            std::vector<int> &mine = activeEdges[t];
+            std::size_t kept = 0;
+            for (int e : mine)
+            {
+                int cu = component[edges.from[e]], cv = component[edges.to[e]];
+                if (cu == cv)
+                    continue;
+                mine[kept++] = e;
+                offer(cu, e);
+                offer(cv, e);
+            }
+            mine.resize(kept); });
+
+        // Step 2: hook every component to the one across its lightest edge, all threads uniting in the
+        // same union-find. When two components picked the same edge, only the first unite succeeds,
+        // so every edge is taken once.
+        parallelFor(components.size(), threadCount, [&](std::size_t begin, std::size_t end, unsigned t)
+                    {
+            picked[t].clear();
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                int e = best[components[k]].load(std::memory_order_relaxed);
+                if (e >= 0 && uf.unite(edges.from[e], edges.to[e]))
+                    picked[t].push_back(e);
+            } });
+
+        std::size_t pickedCount = 0;
+        for (const std::vector<int> &part : picked)
+        {
+            mstEdges.insert(mstEdges.end(), part.begin(), part.end());
+            pickedCount += part.size();
+        }
+        if (pickedCount == 0)
+            break;
+
+        // Step 3: relabel the vertices and keep the roots that still have outgoing edges. The finds
+        // run concurrently and shorten the paths for each other.
+        parallelFor(vertexCount, threadCount, [&](std::size_t begin, std::size_t end, unsigned)
+                    {
+            for (std::size_t v = begin; v < end; ++v)
+                component[v] = uf.find(static_cast<int>(v)); });
+        parallelFor(components.size(), threadCount, [&](std::size_t begin, std::size_t end, unsigned t)
+                    {
+            survivors[t].clear();
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                int c = components[k];
+                if (component[c] == c && best[c].load(std::memory_order_relaxed) >= 0)
+                    survivors[t].push_back(c);
+            } });
+        components.clear();
+        for (const std::vector<int> &part : survivors)
+            components.insert(components.end(), part.begin(), part.end());
+    }
+
+    EdgeList mst;
+    mst.reserve(mstEdges.size());
+    for (int e : mstEdges)
+        mst.push_back(edges.from[e], edges.to[e], edges.weight[e], edges.id[e]);
+
+    return mst;
+}
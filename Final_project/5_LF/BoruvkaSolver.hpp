@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "ConcurrentUnionFind.hpp"
+
+// Parallel Borůvka: every round finds the lightest edge leaving each component on all threads,
+// then contracts the components along those edges in a shared lock-free union-find. O(log V) rounds; ties are broken by edge
+// position, so the result is a minimum spanning forest even with equal weights.
+class BoruvkaSolver : public MSTSolver
+{
+public:
+    // threads = 0 picks a thread count from the edge count and the hardware
+    explicit BoruvkaSolver(unsigned threads = 0) : threads(threads) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    unsigned threads;
+
+    // Working arrays, kept across solves
+    ConcurrentUnionFind uf;                   // Shared by the threads that hook the components
+    std::vector<int> component;               // Component (union-find root) of each vertex, as of the round start
+    std::unique_ptr<std::atomic<int>[]> best; // Lightest edge leaving each component
+    int bestCapacity = 0;                     // Length of 'best'
+    std::vector<int> components;              // Components that may still have outgoing edges
+    std::vector<int> mstEdges;
+    std::vector<std::vector<int>> activeEdges, picked, survivors; // Per thread
+};
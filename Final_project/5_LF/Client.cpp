@@ -1,6 +1,8 @@
 #include "Client.hpp"
 #include <iostream>
 #include <string>
+#include <fstream>
+#include <vector>
 #include <unistd.h>
 #include <arpa/inet.h>
 
@@ -47,6 +49,46 @@ void Client::sendRequest(const std::string &request)
     fsync(client_fd);
 }
 
+// Reads "from to weight" lines from a file and sends them as a single binary block:
+// the bytes "AddEdges", an int32 edge count, then the (from, to, weight) int32 triples
+bool Client::sendEdgeFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Cannot open edge file " << path << "\n";
+        return false;
+    }
+
+    std::vector<int32_t> triples;
+    int32_t from, to, weight;
+    while (file >> from >> to >> weight)
+    {
+        triples.push_back(from);
+        triples.push_back(to);
+        triples.push_back(weight);
+    }
+
+    int32_t count = triples.size() / 3;
+    std::string block = "AddEdges";
+    block.append(reinterpret_cast<const char *>(&count), sizeof(count));
+    block.append(reinterpret_cast<const char *>(triples.data()), triples.size() * sizeof(int32_t));
+
+    size_t totalSent = 0;
+    while (totalSent < block.size())
+    {
+        ssize_t sentBytes = send(client_fd, block.data() + totalSent, block.size() - totalSent, 0);
+        if (sentBytes <= 0)
+        {
+            std::cerr << "Failed to send edge block\n";
+            return false;
+        }
+        totalSent += sentBytes;
+    }
+    std::cout << "Sent " << count << " edges\n";
+    return true;
+}
+
 std::string Client::receiveResponse()
 {
     int32_t responseSize = 0;
@@ -95,7 +137,7 @@ int main()
     {
 
         std::string command;
-        std::cout << "Enter command (NewGraph, AddEdge, RemoveEdge, SolveMST Prim, SolveMST Kruskal): ";
+        std::cout << "Enter command (NewGraph, AddEdge, AddEdges <file>, RemoveEdge, LoadGraph <file>, SaveGraph <file>, ImportGraph <file> <edgelist|dimacs|metis> [collapse], SolveMST Prim|HeapPrim|PrimDense|Kruskal|Boruvka|FilterKruskal|RadixKruskal|LazyKruskal|Auto [BFS|RCM] [All|Weight|Components|Distances]): ";
         std::getline(std::cin, command);
 
         if (command == "quit")
@@ -104,6 +146,12 @@ int main()
             break;
         }
 
+        if (command.substr(0, 9) == "AddEdges ")
+        {
+            client.sendEdgeFile(command.substr(9));
+            continue;
+        }
+
         client.sendRequest(command);
 
         if (command.substr(0, 8) == "SolveMST")
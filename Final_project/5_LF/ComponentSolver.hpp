@@ -0,0 +1,122 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "Parallel.hpp"
+#include "union_find.hpp"
+
+// Splits a fragmented graph for solving its connected components in parallel. The components are
+// dealt into one batch per thread, heaviest first onto the lightest batch, and every batch is solved
+// as a graph of its own; the forests of the batches together are the minimum spanning forest of the
+// graph. Graphs too small for several threads, with fewer components than threads, or with one
+// component holding most of the edges are not split. Shared by ComponentSolver and ComponentSplit.
+class ComponentBatches
+{
+public:
+    // Plans the batches of a graph for 'threads' threads; threads = 0 picks a thread count from the
+    // edge count and the hardware. Returns false if the graph is better solved whole.
+    bool plan(const Graph &graph, unsigned threads);
+
+    // Solves the planned batches on their own threads, solveBatch(batch) returning the forest of a
+    // batch graph, and renames the forests' vertices back to the vertices of 'graph'
+    template <typename SolveBatch>
+    EdgeList solve(const Graph &graph, SolveBatch solveBatch)
+    {
+        std::vector<EdgeList> forests(batchCount);
+        parallelFor(batchCount, batchCount, [&](std::size_t begin, std::size_t end, unsigned)
+                    {
+            for (std::size_t b = begin; b < end; ++b)
+            {
+                Graph batch = graph.subgraph(slots[b], localId, static_cast<int>(globalId[b].size()));
+                forests[b] = solveBatch(batch);
+                for (std::size_t i = 0; i < forests[b].size(); ++i)
+                {
+                    forests[b].from[i] = globalId[b][forests[b].from[i]];
+                    forests[b].to[i] = globalId[b][forests[b].to[i]];
+                }
+            } });
+
+        int vertexCount = graph.getVertexCount();
+        EdgeList mst;
+        mst.reserve(vertexCount > 0 ? vertexCount - 1 : 0);
+        for (const EdgeList &forest : forests)
+            for (std::size_t i = 0; i < forest.size(); ++i)
+                mst.push_back(forest.from[i], forest.to[i], forest.weight[i], forest.id[i]);
+        return mst;
+    }
+
+    // Number of batches of the last plan, 1 if the graph was left whole
+    unsigned batches() const { return batchCount; }
+
+private:
+    unsigned batchCount = 1;
+
+    // Labeling of the components, kept across plans: the graphs left whole allocate nothing here
+    SparseUnionFind uf{0};
+    std::vector<int> component;
+    std::vector<std::size_t> edgeCount;
+
+    std::vector<VertexId> localId;               // Number of every vertex in its batch
+    std::vector<std::vector<VertexId>> globalId; // Vertices of every batch, by their number in it
+    std::vector<std::vector<int>> slots;         // Edges of every batch, as positions in the graph's edge list
+};
+
+// Solves the connected components of a fragmented graph in parallel (see ComponentBatches), every
+// batch by a fresh single-threaded solver. Graphs that are not split go whole to the solver given
+// for them.
+class ComponentSolver : public MSTSolver
+{
+public:
+    using SolverMaker = std::function<std::unique_ptr<MSTSolver>()>;
+
+    // 'solver' handles whole graphs; 'makeBatchSolver' creates the solver of each batch.
+    // threads = 0 picks a thread count from the edge count and the hardware.
+    ComponentSolver(std::unique_ptr<MSTSolver> solver, SolverMaker makeBatchSolver, unsigned threads = 0)
+        : solver(std::move(solver)), makeBatchSolver(std::move(makeBatchSolver)), threads(threads) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    std::unique_ptr<MSTSolver> solver;
+    SolverMaker makeBatchSolver;
+    unsigned threads;
+    ComponentBatches batches;
+};
+
+// ComponentSolver for a solver type known at compile time, for MSTContext: whole graphs go to a
+// member Solver and every batch to a fresh single-threaded Solver, both called without the vtable
+template <typename Solver>
+class ComponentSplit : public MSTSolver
+{
+public:
+    // threads = 0 picks a thread count from the edge count and the hardware
+    explicit ComponentSplit(unsigned threads = 0) : threads(threads) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override
+    {
+        if (!batches.plan(graph, threads))
+            return solver.Solver::computeMSTEdges(graph);
+        return batches.solve(graph, [](const Graph &batch)
+                             { return batchSolver().Solver::computeMSTEdges(batch); });
+    }
+
+    // Number of batches of the last solve, 1 if the graph went whole to the solver
+    unsigned lastBatchCount() const { return batches.batches(); }
+
+private:
+    Solver solver;
+    ComponentBatches batches;
+    unsigned threads;
+
+    // The parallel solvers take a thread count and run on a single thread per batch
+    static Solver batchSolver()
+    {
+        if constexpr (std::is_constructible_v<Solver, unsigned>)
+            return Solver(1u);
+        else
+            return Solver();
+    }
+};
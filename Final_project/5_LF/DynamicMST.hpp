@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "Graph.hpp"
+#include "LinkCutTree.hpp"
+
+// A minimum spanning forest kept up to date while edges are added to and removed from its
+// graph, so the next SolveMST doesn't have to start over. The forest lives in a link-cut tree
+// in which every tree edge is a node of its own, carrying the edge's weight, between its two
+// endpoints.
+//  - A new edge either joins two trees or closes a cycle, whose heaviest edge is found and
+//    swapped out if the new edge is lighter; O(log V) either way.
+//  - Removing a non-tree edge leaves the forest as it is. Removing a tree edge splits its tree;
+//    the non-tree edges are scanned by increasing weight for the first one whose endpoints the
+//    link-cut tree finds on the two sides of the cut, which replaces it. Each test is O(log V),
+//    and no other vertex is visited.
+// The non-tree edges are only indexed on the first removal of a tree edge, so a graph that only
+// grows never pays for the index. Removals that touch the forest are the expensive updates, so
+// touchesForest() lets the caller run them outside its locks.
+class DynamicMST
+{
+public:
+    // Starts from a minimum spanning forest 'mst' of a graph with 'vertexCount' vertices
+    DynamicMST(int vertexCount, const EdgeList &mst);
+
+    // Updates the forest for an edge just added to the graph. Returns true if the forest changed.
+    bool addEdge(VertexId from, VertexId to, Weight weight, int id);
+
+    // Updates the forest for edges just removed from 'graph', given by their IDs.
+    // Returns true if the forest changed.
+    bool removeEdges(const std::vector<int> &ids, const Graph &graph);
+
+    // Whether any of the edges is in the forest. Only then does removeEdges search for replacements
+    // (and index the non-tree edges the first time); otherwise it is O(log E) per edge.
+    bool touchesForest(const std::vector<int> &ids) const;
+
+    // The current forest
+    const EdgeList &edges() const { return forest; }
+
+    // Number of changes made to the forest so far
+    std::uint64_t version() const { return changes; }
+
+private:
+    // A graph edge outside the forest, ordered by weight (then ID) in the replacement index
+    struct NonTreeEdge
+    {
+        Weight weight;
+        int id;
+        VertexId from, to;
+
+        bool operator<(const NonTreeEdge &other) const
+        {
+            return weight < other.weight || (weight == other.weight && id < other.id);
+        }
+    };
+
+    int vertexCount;
+    EdgeList forest;                          // Slot s holds the tree edge represented by node vertexCount + s
+    LinkCutTree tree;                         // Vertex nodes first, then one node per slot of 'forest'
+    std::unordered_map<int, std::size_t> slotOf; // Slot of every tree edge, by edge ID
+
+    bool indexed = false;                     // Whether the two members below are built
+    std::set<NonTreeEdge> nonTree;
+    std::unordered_map<int, std::set<NonTreeEdge>::iterator> nonTreeById;
+
+    std::uint64_t changes = 0;
+
+    // Puts the edge in slot s and links its node between the endpoints
+    void attach(std::size_t slot, VertexId from, VertexId to, Weight weight, int id);
+
+    // Unlinks the node of slot s and forgets its edge; the slot itself stays in 'forest'
+    void detach(std::size_t slot);
+
+    // Removes the tree edge in slot s, and links the lightest edge across the cut in its place if any
+    void removeTreeEdge(std::size_t slot);
+
+    void indexNonTreeEdges(const Graph &graph);
+    void addNonTreeEdge(VertexId from, VertexId to, Weight weight, int id);
+};
@@ -0,0 +1,182 @@
+#include "FilterKruskalSolver.hpp"
+#include "Parallel.hpp"
+#include "ConcurrentUnionFind.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Below this many edges a range is simply sorted
+    constexpr std::size_t BASE_CASE_EDGES = 1 << 12;
+
+    class FilterKruskal
+    {
+    public:
+        FilterKruskal(const EdgeView &edges, int vertexCount, unsigned maxThreads, FilterKruskalSolver::Workspace &work)
+            : edges(edges), work(work), uf(work.uf), maxThreads(maxThreads), scratch(work.scratch)
+        {
+            uf.reset(vertexCount);
+            scratch.resize(edges.size());
+        }
+
+        // Adds the MST edges among order[first, last) to 'mst', lightest first
+        void solve(std::vector<int> &order, std::size_t first, std::size_t last, EdgeList &mst)
+        {
+            if (uf.componentCount() <= 1 || first == last)
+                return;
+            if (last - first <= BASE_CASE_EDGES)
+            {
+                std::sort(order.begin() + first, order.begin() + last, [this](int a, int b)
+                          { return edges.weight[a] < edges.weight[b]; });
+                unite(order, first, last, mst);
+                return;
+            }
+
+            // Three-way partition: [first, lightEnd) < pivot, [lightEnd, equalEnd) == pivot, rest > pivot.
+            // Keeping the equal edges apart guarantees progress even when every weight is the same.
+            Weight pivot = pickPivot(order, first, last);
+            std::size_t lightEnd, equalEnd;
+            partition(order, first, last, pivot, lightEnd, equalEnd);
+
+            solve(order, first, lightEnd, mst);
+            std::size_t kept = filter(order, lightEnd, equalEnd);
+            unite(order, lightEnd, lightEnd + kept, mst); // Same weight, any order is sorted
+            kept = filter(order, equalEnd, last);
+            solve(order, equalEnd, equalEnd + kept, mst);
+        }
+
+    private:
+        const EdgeView &edges;
+        FilterKruskalSolver::Workspace &work;
+        ConcurrentUnionFind &uf;
+        unsigned maxThreads;
+        std::vector<int> &scratch; // Partition buffer, same positions as 'order'
+        std::minstd_rand random{12345};
+
+        void unite(const std::vector<int> &order, std::size_t first, std::size_t last, EdgeList &mst)
+        {
+            for (std::size_t k = first; k < last && uf.componentCount() > 1; ++k)
+            {
+                int e = order[k];
+                if (uf.unite(edges.from[e], edges.to[e]))
+                    mst.push_back(edges.from[e], edges.to[e], edges.weight[e], edges.id[e]);
+            }
+        }
+
+        // Median weight of three random edges of the range
+        Weight pickPivot(const std::vector<int> &order, std::size_t first, std::size_t last)
+        {
+            std::uniform_int_distribution<std::size_t> position(first, last - 1);
+            Weight a = edges.weight[order[position(random)]];
+            Weight b = edges.weight[order[position(random)]];
+            Weight c = edges.weight[order[position(random)]];
+            return std::max(std::min(a, b), std::min(std::max(a, b), c));
+        }
+
+        // Every thread counts its share of each class, then scatters its edges at the prefix offsets
+        void partition(std::vector<int> &order, std::size_t first, std::size_t last, Weight pivot,
+                       std::size_t &lightEnd, std::size_t &equalEnd)
+        {
+            std::size_t count = last - first;
+            unsigned threads = std::min(maxThreads, threadCountFor(count));
+            std::vector<std::size_t> &light = work.light, &equal = work.equal, &heavy = work.heavy;
+            light.assign(threads, 0);
+            equal.assign(threads, 0);
+            heavy.assign(threads, 0);
+            parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned t)
+                        {
+                for (std::size_t k = first + begin; k < first + end; ++k)
+                {
+                    Weight w = edges.weight[order[k]];
+                    light[t] += w < pivot;
+                    equal[t] += w == pivot;
+                }
+                heavy[t] = end - begin - light[t] - equal[t]; });
+
+            std::size_t lightTotal = std::accumulate(light.begin(), light.end(), std::size_t(0));
+            std::size_t equalTotal = std::accumulate(equal.begin(), equal.end(), std::size_t(0));
+            std::vector<std::size_t> &lightAt = work.lightAt, &equalAt = work.equalAt, &heavyAt = work.heavyAt;
+            lightAt.resize(threads);
+            equalAt.resize(threads);
+            heavyAt.resize(threads);
+            std::size_t l = first, e = first + lightTotal, h = first + lightTotal + equalTotal;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                lightAt[t] = l;
+                equalAt[t] = e;
+                heavyAt[t] = h;
+                l += light[t];
+                e += equal[t];
+                h += heavy[t];
+            }
+
+            parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned t)
+                        {
+                std::size_t l = lightAt[t], e = equalAt[t], h = heavyAt[t];
+                for (std::size_t k = first + begin; k < first + end; ++k)
+                {
+                    int edge = order[k];
+                    Weight w = edges.weight[edge];
+                    if (w < pivot)
+                        scratch[l++] = edge;
+                    else if (w == pivot)
+                        scratch[e++] = edge;
+                    else
+                        scratch[h++] = edge;
+                } });
+            parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned)
+                        { std::copy(scratch.begin() + first + begin, scratch.begin() + first + end, order.begin() + first + begin); });
+
+            lightEnd = first + lightTotal;
+            equalEnd = lightEnd + equalTotal;
+        }
+
+        // Moves the edges of order[first, last) that join two different trees to the front of the range
+        // and returns how many there are. The threads share the lock-free union-find; no unite runs
+        // meanwhile, and the finds of each thread halve the paths for the others.
+        std::size_t filter(std::vector<int> &order, std::size_t first, std::size_t last)
+        {
+            std::size_t count = last - first;
+            unsigned threads = std::min(maxThreads, threadCountFor(count));
+            std::vector<std::size_t> &kept = work.kept;
+            kept.assign(threads, 0);
+            parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned t)
+                        {
+                std::size_t out = first + begin;
+                for (std::size_t k = first + begin; k < first + end; ++k)
+                {
+                    int e = order[k];
+                    order[out] = e;
+                    out += uf.find(edges.from[e]) != uf.find(edges.to[e]);
+                }
+                kept[t] = out - first - begin; });
+
+            // Close the gaps between the threads' kept blocks
+            std::size_t out = first;
+            for (unsigned t = 0; t < threads; ++t)
+            {
+                std::size_t begin = first + count * t / threads;
+                std::copy(order.begin() + begin, order.begin() + begin + kept[t], order.begin() + out);
+                out += kept[t];
+            }
+            return out - first;
+        }
+    };
+}
+
+EdgeList FilterKruskalSolver::computeMSTEdges(const Graph &graph)
+{
+    EdgeView edges = graph.getEdges();
+    unsigned maxThreads = threads ? threads : threadCountFor(edges.size());
+    EdgeList mst;
+    mst.reserve(graph.getVertexCount() > 0 ? graph.getVertexCount() - 1 : 0);
+
+    std::vector<int> &order = workspace.order;
+    order.resize(edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    FilterKruskal(edges, graph.getVertexCount(), maxThreads, workspace).solve(order, 0, order.size(), mst);
+
+    return mst;
+}
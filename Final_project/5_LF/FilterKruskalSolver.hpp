@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "ConcurrentUnionFind.hpp"
+
+// Filter-Kruskal: partitions the edges around a pivot weight, solves the light part first,
+// then drops the heavy edges whose endpoints are already connected before handling them.
+// Most heavy edges of a dense graph are dropped unsorted. Large partitions and filters run in parallel.
+class FilterKruskalSolver : public MSTSolver
+{
+public:
+    // threads = 0 picks a thread count from the edge count and the hardware
+    explicit FilterKruskalSolver(unsigned threads = 0) : threads(threads) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+    // Working arrays of a solve, kept by the solver for the next one
+    struct Workspace
+    {
+        ConcurrentUnionFind uf;
+        std::vector<int> order, scratch; // Edge indices, and the partition buffer at the same positions
+        std::vector<std::size_t> light, equal, heavy, lightAt, equalAt, heavyAt, kept; // Per-thread counts and offsets
+    };
+
+private:
+    unsigned threads;
+    Workspace workspace;
+};
@@ -1,39 +1,278 @@
 #pragma once
-#include <tuple>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "EdgeList.hpp"
+#include "Adjacency.hpp"
+#include "GraphFile.hpp"
+#include "Parallel.hpp"
 
 class Graph
 {
 private:
     int vertexCount;
-    std::vector<std::tuple<int, int, int, int>> edges; // Stores edges as (from, to, weight, id)
-    int edgeCounter = 0;                               // Unique ID for each undirected edge
+    EdgeList edges;       // Stores each undirected edge once as (from, to, weight, id)
+    int edgeCounter = 0;  // Unique ID for each undirected edge
+
+    // Names the content of the graph: a new graph and every edit take a number that no graph had before,
+    // copies keep it. Two graphs with the same version have the same vertices and edges.
+    std::uint64_t version = newVersion();
+
+    // Index from an unordered vertex pair to the slots in 'edges' that connect it. Only removals need
+    // it, so it is built by the first one: graphs that only grow, like imported ones, never pay for it.
+    std::unordered_map<std::uint64_t, std::vector<int>> edgeIndex;
+    bool indexed = false;
+
+    // CSR snapshot of the edges, built on demand and dropped by every edit. It is immutable once
+    // built, so copies of the graph share it until one of them is edited.
+    mutable std::shared_ptr<const Adjacency> adjacency;
+    mutable std::mutex adjacencyMutex; // Guards the lazy builds, so concurrent solves of one graph are safe
+
+    // When set, the edges and the CSR are read in place from this mapped file instead of the members above
+    std::shared_ptr<const MappedGraphFile> mapped;
+
+    // Key of the unordered pair {u, v}, identical for (u, v) and (v, u)
+    static std::uint64_t pairKey(int u, int v)
+    {
+        if (u > v)
+            std::swap(u, v);
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(u)) << 32) | static_cast<std::uint32_t>(v);
+    }
+
+    // Appends an edge record and registers its slot in the pair index, if it is built
+    void pushEdge(VertexId from, VertexId to, Weight weight, int id)
+    {
+        if (indexed)
+            edgeIndex[pairKey(from, to)].push_back(static_cast<int>(edges.size()));
+        edges.push_back(from, to, weight, id);
+    }
+
+    // Builds the pair index of the edges, once
+    void buildIndex()
+    {
+        if (indexed)
+            return;
+        edgeIndex.reserve(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i)
+            edgeIndex[pairKey(edges.from[i], edges.to[i])].push_back(static_cast<int>(i));
+        indexed = true;
+    }
+
+    // Removes the record at 'slot' in O(1) by moving the last record into its place (swap-and-pop)
+    void eraseSlot(int slot)
+    {
+        int last = static_cast<int>(edges.size()) - 1;
+        if (slot != last)
+        {
+            auto &slots = edgeIndex[pairKey(edges.from[last], edges.to[last])];
+            *std::find(slots.begin(), slots.end(), last) = slot;
+        }
+        edges.eraseSwap(slot);
+    }
+
+    // Drops the CSR snapshot after an edit
+    void dropSnapshots()
+    {
+        adjacency.reset();
+    }
+
+    // Next number of the version sequence shared by all graphs
+    static std::uint64_t newVersion()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+    // Called at the end of every edit
+    void edited()
+    {
+        dropSnapshots();
+        version = newVersion();
+    }
+
+    // Copies a mapped graph into owned storage, so it can be edited. Called at the start of every edit.
+    void materialize()
+    {
+        if (!mapped)
+            return;
+
+        EdgeView view = mapped->edges();
+        edges.from.assign(view.from, view.from + view.size());
+        edges.to.assign(view.to, view.to + view.size());
+        edges.weight.assign(view.weight, view.weight + view.size());
+        edges.id.assign(view.id, view.id + view.size());
+        edgeIndex.clear();
+        indexed = false;
+        edgeCounter = mapped->nextEdgeId();
+        mapped.reset();
+        dropSnapshots();
+    }
 
 public:
     Graph() : vertexCount(0) {} // Default constructor
     Graph(int n) : vertexCount(n) {}
 
-    // Adds an edge between two vertices in both directions (undirected) with the same ID
-    void addEdge(int from, int to, int weight)
+    // Copies are the versions of a copy-on-write graph: the edge store is duplicated, the snapshots are shared
+    Graph(const Graph &other)
+        : vertexCount(other.vertexCount), edges(other.edges), edgeCounter(other.edgeCounter),
+          version(other.version), edgeIndex(other.edgeIndex), indexed(other.indexed), mapped(other.mapped)
+    {
+        std::lock_guard<std::mutex> lock(other.adjacencyMutex);
+        adjacency = other.adjacency;
+    }
+    Graph &operator=(const Graph &) = delete;
+
+    // Creates a graph that reads its edges and CSR straight from a mapped graph file
+    static Graph fromMappedFile(std::shared_ptr<const MappedGraphFile> file)
+    {
+        Graph graph(file->vertexCount());
+        graph.edgeCounter = file->nextEdgeId();
+        graph.mapped = std::move(file);
+        return graph;
+    }
+
+    // True if v is a vertex of this graph
+    bool hasVertex(long long v) const
+    {
+        return v >= 0 && v < vertexCount;
+    }
+
+    // Adds an undirected edge between two vertices. It is stored as a single record;
+    // both directions are exposed through the CSR adjacency.
+    // Returns false, without adding anything, if an endpoint is out of range.
+    bool addEdge(int from, int to, Weight weight)
     {
-        int currentId = edgeCounter++;                   // Assign a unique ID to this undirected edge
-        edges.emplace_back(from, to, weight, currentId); // Edge from -> to
-        edges.emplace_back(to, from, weight, currentId); // Edge to -> from, with the same ID
+        if (!hasVertex(from) || !hasVertex(to))
+            return false;
+        materialize();
+        pushEdge(from, to, weight, edgeCounter++); // Assign a unique ID to this undirected edge
+        edited();
+        return true;
     }
 
-    // Removes an edge between two vertices in both directions (undirected)
-    void removeEdge(int from, int to)
+    // Appends a block of (from, to, weight) triples. The block is validated first and
+    // rejected as a whole if any endpoint is out of range; capacity is reserved up front.
+    // Returns false if the block was rejected.
+    bool addEdges(const std::int32_t *triples, std::size_t count)
     {
-        edges.erase(std::remove_if(edges.begin(), edges.end(),
-                                   [from, to](const std::tuple<int, int, int, int> &edge)
-                                   {
-                                       int u, v;
-                                       std::tie(u, v, std::ignore, std::ignore) = edge;
-                                       return (u == from && v == to) || (u == to && v == from);
-                                   }),
-                    edges.end());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (!hasVertex(triples[3 * i]) || !hasVertex(triples[3 * i + 1]))
+                return false;
+        }
+
+        materialize();
+        reserveEdges(edges.size() + count);
+        for (std::size_t i = 0; i < count; ++i)
+            pushEdge(static_cast<VertexId>(triples[3 * i]), static_cast<VertexId>(triples[3 * i + 1]),
+                     static_cast<Weight>(triples[3 * i + 2]), edgeCounter++);
+        edited();
+        return true;
+    }
+
+    // Same as above for a block of edges in an edge list; the IDs of the block are ignored
+    // and new ones are assigned. Returns false if the block was rejected.
+    bool addEdges(const EdgeView &block)
+    {
+        for (std::size_t i = 0; i < block.size(); ++i)
+        {
+            if (!hasVertex(block.from[i]) || !hasVertex(block.to[i]))
+                return false;
+        }
+
+        materialize();
+        reserveEdges(edges.size() + block.size());
+        for (std::size_t i = 0; i < block.size(); ++i)
+            pushEdge(block.from[i], block.to[i], block.weight[i], edgeCounter++);
+        edited();
+        return true;
+    }
+
+    // Reserves room for 'count' edges in total, so a graph built from several blocks grows only once
+    void reserveEdges(std::size_t count)
+    {
+        if (count <= edges.id.capacity())
+            return;
+        edges.reserve(count);
+        if (indexed)
+            edgeIndex.reserve(count);
+    }
+
+    // Appends blocks of edges, e.g. the chunks of a parsed file, numbering them in block order. The
+    // blocks are validated and copied into place in parallel, on up to 'threads' threads (0 picks a
+    // count from the edge count and the hardware). All of them are rejected if any endpoint is out
+    // of range. Returns false if they were rejected.
+    bool addEdgeBlocks(const std::vector<EdgeView> &blocks, unsigned threads = 0)
+    {
+        std::vector<std::size_t> offset(blocks.size() + 1, 0);
+        for (std::size_t b = 0; b < blocks.size(); ++b)
+            offset[b + 1] = offset[b] + blocks[b].size();
+        unsigned workers = static_cast<unsigned>(
+            std::min<std::size_t>(threads ? threads : threadCountFor(offset.back()), std::max<std::size_t>(1, blocks.size())));
+
+        std::vector<char> valid(blocks.size(), 1);
+        parallelFor(blocks.size(), workers, [&](std::size_t begin, std::size_t end, unsigned)
+                    {
+            for (std::size_t b = begin; b < end; ++b)
+                for (std::size_t i = 0; i < blocks[b].size() && valid[b]; ++i)
+                    valid[b] = hasVertex(blocks[b].from[i]) && hasVertex(blocks[b].to[i]); });
+        if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+            return false;
+
+        materialize();
+        std::size_t first = edges.size();
+        edges.resize(first + offset.back());
+        parallelFor(blocks.size(), workers, [&](std::size_t begin, std::size_t end, unsigned)
+                    {
+            for (std::size_t b = begin; b < end; ++b)
+            {
+                const EdgeView &block = blocks[b];
+                std::size_t at = first + offset[b];
+                std::copy(block.from, block.from + block.size(), edges.from.begin() + at);
+                std::copy(block.to, block.to + block.size(), edges.to.begin() + at);
+                std::copy(block.weight, block.weight + block.size(), edges.weight.begin() + at);
+                std::iota(edges.id.begin() + at, edges.id.begin() + at + block.size(), edgeCounter + static_cast<int>(offset[b]));
+            } });
+        if (indexed)
+            for (std::size_t i = first; i < edges.size(); ++i)
+                edgeIndex[pairKey(edges.from[i], edges.to[i])].push_back(static_cast<int>(i));
+        edgeCounter += static_cast<int>(offset.back());
+        edited();
+        return true;
+    }
+
+    // Removes every edge between two vertices, regardless of the direction it was added in,
+    // and returns the IDs of the removed edges.
+    // Runs in time proportional to the number of removed records, not to the edge count, once the
+    // first removal has built the pair index.
+    std::vector<int> removeEdge(int from, int to)
+    {
+        materialize();
+        buildIndex();
+        auto it = edgeIndex.find(pairKey(from, to));
+        if (it == edgeIndex.end())
+            return {};
+
+        std::vector<int> slots = std::move(it->second);
+        edgeIndex.erase(it);
+
+        // Erase from the highest slot down, so the record moved into a hole never belongs to this pair
+        std::sort(slots.rbegin(), slots.rend());
+        std::vector<int> ids;
+        ids.reserve(slots.size());
+        for (int slot : slots)
+        {
+            ids.push_back(edges.id[slot]);
+            eraseSlot(slot);
+        }
+        edited();
+        return ids;
     }
 
     int getVertexCount() const
@@ -41,8 +280,80 @@ public:
         return vertexCount;
     }
 
-    const std::vector<std::tuple<int, int, int, int>> &getEdges() const
+    // ID that the next added edge will get
+    int getNextEdgeId() const
+    {
+        return edgeCounter;
+    }
+
+    // Version of the graph's content, changed by every edit
+    std::uint64_t getVersion() const
+    {
+        return version;
+    }
+
+    // Returns the edge list, holding each undirected edge exactly once
+    EdgeView getEdges() const
+    {
+        return mapped ? mapped->edges() : edges.view();
+    }
+
+    // Returns the CSR adjacency of the graph, listing every edge in both directions.
+    // It is rebuilt lazily, only after the graph was edited. Safe to call from several threads.
+    AdjacencyView getAdjacency() const
+    {
+        if (mapped)
+            return mapped->adjacency();
+        std::lock_guard<std::mutex> lock(adjacencyMutex);
+        if (!adjacency)
+            adjacency = std::make_shared<const Adjacency>(Adjacency::build(edges.view(), vertexCount));
+        return adjacency->view();
+    }
+
+    // Returns a copy of the graph in which vertex order[k] is renamed k. Edge IDs are kept,
+    // and the edges are listed grouped by their renamed lower endpoint.
+    std::unique_ptr<Graph> relabeled(const std::vector<VertexId> &order) const
+    {
+        std::vector<VertexId> newId(vertexCount);
+        for (int k = 0; k < vertexCount; ++k)
+            newId[order[k]] = static_cast<VertexId>(k);
+
+        // Counting sort of the edges by their renamed lower endpoint
+        EdgeView view = getEdges();
+        std::vector<int> first(vertexCount + 1, 0);
+        auto lower = [&](std::size_t i)
+        { return std::min(newId[view.from[i]], newId[view.to[i]]); };
+        for (std::size_t i = 0; i < view.size(); ++i)
+            ++first[lower(i) + 1];
+        std::partial_sum(first.begin(), first.end(), first.begin());
+        std::vector<int> byEndpoint(view.size());
+        for (std::size_t i = 0; i < view.size(); ++i)
+            byEndpoint[first[lower(i)]++] = static_cast<int>(i);
+
+        auto graph = std::make_unique<Graph>(vertexCount);
+        graph->edgeCounter = edgeCounter;
+        graph->reserveEdges(view.size());
+        for (int i : byEndpoint)
+            graph->pushEdge(newId[view.from[i]], newId[view.to[i]], view.weight[i], view.id[i]);
+        return graph;
+    }
+
+    // Returns a graph on 'count' vertices holding the edges at the given positions of getEdges(),
+    // with every endpoint v renamed newId[v]. Edge IDs are kept.
+    Graph subgraph(const std::vector<int> &slots, const std::vector<VertexId> &newId, int count) const
+    {
+        EdgeView view = getEdges();
+        Graph graph(count);
+        graph.edgeCounter = edgeCounter;
+        graph.reserveEdges(slots.size());
+        for (int i : slots)
+            graph.pushEdge(newId[view.from[i]], newId[view.to[i]], view.weight[i], view.id[i]);
+        return graph;
+    }
+
+    // Saves the graph in the binary graph file format
+    bool save(const std::string &path, std::string &error) const
     {
-        return edges;
+        return writeGraphFile(path, vertexCount, edgeCounter, getEdges(), getAdjacency(), error);
     }
 };
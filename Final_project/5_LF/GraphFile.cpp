@@ -0,0 +1,195 @@
+#include "GraphFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char GRAPH_FILE_MAGIC[8] = {'M', 'S', 'T', 'G', 'R', 'A', 'P', 'H'};
+static const std::size_t GRAPH_FILE_ALIGNMENT = 8;
+
+// Size of an array of 'count' elements, rounded up to the alignment of the next array
+static std::size_t paddedBytes(std::size_t count, std::size_t elementSize)
+{
+    return (count * elementSize + GRAPH_FILE_ALIGNMENT - 1) / GRAPH_FILE_ALIGNMENT * GRAPH_FILE_ALIGNMENT;
+}
+
+// Total file size for the given counts with this build's VertexId and Weight
+static std::size_t graphFileBytes(std::size_t vertices, std::size_t edges)
+{
+    return sizeof(GraphFileHeader) +
+           2 * paddedBytes(edges, sizeof(VertexId)) + paddedBytes(edges, sizeof(Weight)) + paddedBytes(edges, sizeof(int)) +
+           paddedBytes(vertices + 1, sizeof(int)) +
+           paddedBytes(2 * edges, sizeof(VertexId)) + paddedBytes(2 * edges, sizeof(Weight)) + paddedBytes(2 * edges, sizeof(int));
+}
+
+// Checks that every vertex index in the array lies in [0, vertexCount).
+// Negative values wrap around to huge unsigned ones, so a single comparison covers both bounds.
+static bool verticesInRange(const VertexId *values, std::size_t count, int vertexCount)
+{
+    bool valid = true;
+    for (std::size_t i = 0; i < count; ++i)
+        valid &= static_cast<std::uint64_t>(static_cast<std::int64_t>(values[i])) < static_cast<std::uint64_t>(vertexCount);
+    return valid;
+}
+
+std::shared_ptr<const MappedGraphFile> MappedGraphFile::open(const std::string &path, std::string &error)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error = "cannot open " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<std::size_t>(info.st_size) < sizeof(GraphFileHeader))
+    {
+        error = path + " is not a graph file (too short)";
+        ::close(fd);
+        return nullptr;
+    }
+
+    std::size_t length = info.st_size;
+    void *data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+    if (data == MAP_FAILED)
+    {
+        error = "cannot map " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedGraphFile> file(new MappedGraphFile());
+    file->data = data;
+    file->length = length;
+    file->header = static_cast<const GraphFileHeader *>(data);
+
+    const GraphFileHeader &header = *file->header;
+    if (std::memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) != 0)
+    {
+        error = path + " is not a graph file (bad magic)";
+        return nullptr;
+    }
+    if (header.version != GRAPH_FILE_VERSION)
+    {
+        error = path + " has unsupported version " + std::to_string(header.version);
+        return nullptr;
+    }
+
+    if (header.vertexBytes != sizeof(VertexId) || header.vertexSigned != std::is_signed_v<VertexId> ||
+        header.weightBytes != sizeof(Weight) || header.weightFloat != std::is_floating_point_v<Weight>)
+    {
+        error = path + " was written with different vertex or weight types than this build";
+        return nullptr;
+    }
+
+    const std::int64_t maxInt = std::numeric_limits<int>::max();
+    if (header.vertexCount < 0 || header.vertexCount > MAX_VERTEX_COUNT ||
+        header.edgeCount < 0 || header.edgeCount > maxInt / 2 ||
+        header.nextEdgeId < header.edgeCount || header.nextEdgeId > maxInt)
+    {
+        error = path + " has an invalid header";
+        return nullptr;
+    }
+
+    std::size_t vertices = header.vertexCount, edges = header.edgeCount;
+    if (length != graphFileBytes(vertices, edges))
+    {
+        error = path + " is truncated or has trailing data";
+        return nullptr;
+    }
+
+    // Lay the views over the arrays that follow the header
+    const char *cursor = reinterpret_cast<const char *>(file->header + 1);
+    auto take = [&cursor](auto *&array, std::size_t count)
+    {
+        array = reinterpret_cast<std::remove_reference_t<decltype(array)>>(cursor);
+        cursor += paddedBytes(count, sizeof(*array));
+    };
+    EdgeView &edgeView = file->edgeView;
+    take(edgeView.from, edges);
+    take(edgeView.to, edges);
+    take(edgeView.weight, edges);
+    take(edgeView.id, edges);
+    edgeView.count = edges;
+
+    AdjacencyView &adjacency = file->adjacencyView;
+    take(adjacency.offsets, vertices + 1);
+    take(adjacency.targets, 2 * edges);
+    take(adjacency.weights, 2 * edges);
+    take(adjacency.ids, 2 * edges);
+    adjacency.vertices = static_cast<int>(vertices);
+
+    // The solvers index with these values, so a corrupt file must not get past this point
+    int vertexCount = adjacency.vertices;
+    bool valid = verticesInRange(edgeView.from, edges, vertexCount) &&
+                 verticesInRange(edgeView.to, edges, vertexCount) &&
+                 verticesInRange(adjacency.targets, 2 * edges, vertexCount) &&
+                 adjacency.offsets[0] == 0 && adjacency.offsets[vertices] == static_cast<int>(2 * edges);
+    for (std::size_t v = 0; valid && v < vertices; ++v)
+        valid = adjacency.offsets[v] <= adjacency.offsets[v + 1];
+    if (!valid)
+    {
+        error = path + " has out-of-range vertices or offsets";
+        return nullptr;
+    }
+
+    return file;
+}
+
+MappedGraphFile::~MappedGraphFile()
+{
+    if (data)
+        munmap(data, length);
+}
+
+bool writeGraphFile(const std::string &path, int vertexCount, int nextEdgeId,
+                    const EdgeView &edges, const AdjacencyView &adjacency, std::string &error)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+    header.version = GRAPH_FILE_VERSION;
+    header.vertexBytes = sizeof(VertexId);
+    header.vertexSigned = std::is_signed_v<VertexId>;
+    header.weightBytes = sizeof(Weight);
+    header.weightFloat = std::is_floating_point_v<Weight>;
+    header.vertexCount = vertexCount;
+    header.edgeCount = edges.size();
+    header.nextEdgeId = nextEdgeId;
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    auto put = [&out](const auto *array, std::size_t count)
+    {
+        static const char padding[GRAPH_FILE_ALIGNMENT] = {};
+        std::size_t bytes = count * sizeof(*array);
+        out.write(reinterpret_cast<const char *>(array), bytes);
+        out.write(padding, paddedBytes(count, sizeof(*array)) - bytes);
+    };
+    std::size_t slots = 2 * edges.size();
+    put(edges.from, edges.size());
+    put(edges.to, edges.size());
+    put(edges.weight, edges.size());
+    put(edges.id, edges.size());
+    put(adjacency.offsets, vertexCount + 1);
+    put(adjacency.targets, slots);
+    put(adjacency.weights, slots);
+    put(adjacency.ids, slots);
+
+    if (!out)
+    {
+        error = "failed writing " + path;
+        return false;
+    }
+    return true;
+}
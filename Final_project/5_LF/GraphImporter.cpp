@@ -0,0 +1,442 @@
+#include "GraphImporter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // Result of parsing one chunk of the file
+    struct Chunk
+    {
+        const char *begin = nullptr;
+        const char *end = nullptr;
+        EdgeList edges;               // Parsed edges, 0-based, IDs are assigned when building the Graph
+        long long maxVertex = -1;     // Largest vertex seen (edge list format)
+        long long declaredVertices = -1; // Vertex count from a DIMACS "p" line
+        long long firstVertex = 0;    // METIS: vertex described by the first line of the chunk
+        long long vertexLines = 0;    // METIS: number of vertex lines in the chunk
+        std::string error;
+    };
+
+    // Layout of a METIS file, from its header line
+    struct MetisHeader
+    {
+        long long vertices = 0;
+        bool edgeWeights = false;
+        int skippedValues = 0; // Vertex size and vertex weights that precede the neighbours
+    };
+
+    bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    const char *skipBlanks(const char *p, const char *end)
+    {
+        while (p < end && isBlank(*p))
+            ++p;
+        return p;
+    }
+
+    const char *lineEnd(const char *p, const char *end)
+    {
+        const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        return newline ? newline : end;
+    }
+
+    // Parses the next number of the line, returns false if there is none or it is malformed
+    template <typename T>
+    bool parseNumber(const char *&p, const char *end, T &value)
+    {
+        p = skipBlanks(p, end);
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc() || (next < end && !isBlank(*next)))
+            return false;
+        p = next;
+        return true;
+    }
+
+    bool atLineEnd(const char *p, const char *end)
+    {
+        return skipBlanks(p, end) == end;
+    }
+
+    bool validVertex(long long v)
+    {
+        return v >= 0 && v < MAX_VERTEX_COUNT;
+    }
+
+    std::string errorAt(const char *fileBegin, const char *line, const std::string &what)
+    {
+        return what + " at byte " + std::to_string(line - fileBegin);
+    }
+
+    // Splits [begin, end) into up to 'parts' chunks that start at the beginning of a line
+    std::vector<Chunk> splitChunks(const char *begin, const char *end, unsigned parts)
+    {
+        std::vector<Chunk> chunks;
+        const char *start = begin;
+        for (unsigned i = 1; i <= parts && start < end; ++i)
+        {
+            const char *stop = i == parts ? end : begin + (end - begin) * i / parts;
+            if (stop < start)
+                stop = start;
+            if (stop < end)
+                stop = std::min(end, lineEnd(stop, end) + 1);
+            Chunk chunk;
+            chunk.begin = start;
+            chunk.end = stop;
+            chunks.push_back(std::move(chunk));
+            start = stop;
+        }
+        return chunks;
+    }
+
+    void parseEdgeListChunk(Chunk &chunk, const char *fileBegin)
+    {
+        for (const char *line = chunk.begin; line < chunk.end;)
+        {
+            const char *end = lineEnd(line, chunk.end);
+            const char *p = skipBlanks(line, end);
+            if (p < end && *p != '#' && *p != '%')
+            {
+                long long u, v;
+                Weight w = 1;
+                if (!parseNumber(p, end, u) || !parseNumber(p, end, v) ||
+                    (!atLineEnd(p, end) && !parseNumber(p, end, w)) || !atLineEnd(p, end) ||
+                    !validVertex(u) || !validVertex(v))
+                {
+                    chunk.error = errorAt(fileBegin, line, "malformed edge");
+                    return;
+                }
+                chunk.edges.push_back(static_cast<VertexId>(u), static_cast<VertexId>(v), w, 0);
+                chunk.maxVertex = std::max(chunk.maxVertex, std::max(u, v));
+            }
+            line = end + 1;
+        }
+    }
+
+    void parseDimacsChunk(Chunk &chunk, const char *fileBegin)
+    {
+        for (const char *line = chunk.begin; line < chunk.end;)
+        {
+            const char *end = lineEnd(line, chunk.end);
+            const char *p = skipBlanks(line, end);
+            if (p < end && *p == 'a')
+            {
+                ++p;
+                long long u, v;
+                Weight w;
+                if (!parseNumber(p, end, u) || !parseNumber(p, end, v) || !parseNumber(p, end, w) ||
+                    !atLineEnd(p, end) || !validVertex(u - 1) || !validVertex(v - 1))
+                {
+                    chunk.error = errorAt(fileBegin, line, "malformed arc");
+                    return;
+                }
+                chunk.edges.push_back(static_cast<VertexId>(u - 1), static_cast<VertexId>(v - 1), w, 0);
+            }
+            else if (p < end && *p == 'p')
+            {
+                // "p sp n m"
+                p = skipBlanks(p + 1, end);
+                while (p < end && !isBlank(*p))
+                    ++p;
+                long long n, m;
+                if (!parseNumber(p, end, n) || !parseNumber(p, end, m) || n < 0 || n > MAX_VERTEX_COUNT)
+                {
+                    chunk.error = errorAt(fileBegin, line, "malformed problem line");
+                    return;
+                }
+                chunk.declaredVertices = n;
+            }
+            else if (p < end && *p != 'c')
+            {
+                chunk.error = errorAt(fileBegin, line, "unknown line type");
+                return;
+            }
+            line = end + 1;
+        }
+    }
+
+    // First METIS pass: counts the vertex lines of the chunk (every line that isn't a comment)
+    void countMetisLines(Chunk &chunk)
+    {
+        for (const char *line = chunk.begin; line < chunk.end;)
+        {
+            const char *end = lineEnd(line, chunk.end);
+            chunk.vertexLines += (line == end || *line != '%');
+            line = end + 1;
+        }
+    }
+
+    // Second METIS pass: line k of the chunk lists the neighbours of vertex firstVertex + k
+    void parseMetisChunk(Chunk &chunk, const MetisHeader &header, const char *fileBegin)
+    {
+        long long vertex = chunk.firstVertex;
+        for (const char *line = chunk.begin; line < chunk.end;)
+        {
+            const char *end = lineEnd(line, chunk.end);
+            const char *p = line;
+            if (p < end && *p == '%')
+            {
+                line = end + 1;
+                continue;
+            }
+            if (vertex >= header.vertices)
+            {
+                if (!atLineEnd(p, end))
+                {
+                    chunk.error = errorAt(fileBegin, line, "more vertex lines than declared");
+                    return;
+                }
+                line = end + 1;
+                continue;
+            }
+
+            for (int i = 0; i < header.skippedValues; ++i)
+            {
+                double ignored;
+                if (!parseNumber(p, end, ignored))
+                {
+                    chunk.error = errorAt(fileBegin, line, "missing vertex weight");
+                    return;
+                }
+            }
+            while (!atLineEnd(p, end))
+            {
+                long long neighbour;
+                Weight w = 1;
+                if (!parseNumber(p, end, neighbour) || (header.edgeWeights && !parseNumber(p, end, w)) ||
+                    neighbour < 1 || neighbour > header.vertices)
+                {
+                    chunk.error = errorAt(fileBegin, line, "malformed neighbour");
+                    return;
+                }
+                // Every edge is listed by both endpoints; keep it once
+                if (neighbour - 1 > vertex)
+                    chunk.edges.push_back(static_cast<VertexId>(vertex), static_cast<VertexId>(neighbour - 1), w, 0);
+            }
+            ++vertex;
+            line = end + 1;
+        }
+    }
+
+    // Parses the METIS header line and returns the position right after it
+    const char *parseMetisHeader(const char *begin, const char *end, MetisHeader &header, std::string &error)
+    {
+        const char *line = begin;
+        while (line < end && *line == '%')
+            line = lineEnd(line, end) + 1;
+        if (line >= end)
+        {
+            error = "missing METIS header";
+            return nullptr;
+        }
+
+        const char *stop = lineEnd(line, end);
+        const char *p = line;
+        long long m;
+        if (!parseNumber(p, stop, header.vertices) || !parseNumber(p, stop, m) ||
+            header.vertices < 0 || header.vertices > MAX_VERTEX_COUNT)
+        {
+            error = "malformed METIS header";
+            return nullptr;
+        }
+
+        // fmt is up to three binary digits: vertex sizes, vertex weights, edge weights
+        std::string fmt = "000";
+        long long ncon = 1;
+        p = skipBlanks(p, stop);
+        if (p < stop)
+        {
+            const char *fmtBegin = p;
+            while (p < stop && !isBlank(*p))
+                ++p;
+            fmt = std::string(3 - std::min<std::size_t>(3, p - fmtBegin), '0') + std::string(fmtBegin, p);
+            if (!atLineEnd(p, stop) && !parseNumber(p, stop, ncon))
+            {
+                error = "malformed METIS header";
+                return nullptr;
+            }
+        }
+        header.edgeWeights = fmt[fmt.size() - 1] == '1';
+        header.skippedValues = (fmt[fmt.size() - 3] == '1') + (fmt[fmt.size() - 2] == '1' ? static_cast<int>(ncon) : 0);
+        return std::min(end, stop + 1);
+    }
+
+    // Runs 'work' on every chunk, one thread per chunk
+    template <typename Work>
+    void forEachChunk(std::vector<Chunk> &chunks, Work work)
+    {
+        std::vector<std::thread> workers;
+        for (Chunk &chunk : chunks)
+            workers.emplace_back([&chunk, &work]()
+                                 { work(chunk); });
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    // Keeps a single edge per unordered vertex pair, the lightest one, in parallel: every chunk
+    // deals its edges into one bucket per chunk by a hash of the pair, so all the edges of a pair
+    // land in the same bucket, then every bucket is sorted and deduplicated on its own thread. The
+    // surviving edges of bucket b replace the edges of chunk b.
+    void collapseParallelEdges(std::vector<Chunk> &chunks)
+    {
+        std::size_t bucketCount = chunks.size();
+        auto bucketOf = [bucketCount](VertexId u, VertexId v)
+        {
+            std::uint64_t pair = (static_cast<std::uint64_t>(std::min(u, v)) << 32) | static_cast<std::uint32_t>(std::max(u, v));
+            return static_cast<std::size_t>((pair * 0x9E3779B97F4A7C15ull) >> 32) % bucketCount;
+        };
+
+        std::vector<std::vector<EdgeList>> dealt(chunks.size(), std::vector<EdgeList>(bucketCount));
+        forEachChunk(chunks, [&](Chunk &chunk)
+                     {
+            std::vector<EdgeList> &buckets = dealt[&chunk - chunks.data()];
+            const EdgeList &edges = chunk.edges;
+            for (std::size_t i = 0; i < edges.size(); ++i)
+                buckets[bucketOf(edges.from[i], edges.to[i])].push_back(edges.from[i], edges.to[i], edges.weight[i], 0);
+            chunk.edges = EdgeList(); });
+
+        forEachChunk(chunks, [&](Chunk &chunk)
+                     {
+            std::size_t b = &chunk - chunks.data();
+            EdgeList bucket;
+            std::size_t size = 0;
+            for (const std::vector<EdgeList> &buckets : dealt)
+                size += buckets[b].size();
+            bucket.reserve(size);
+            for (std::vector<EdgeList> &buckets : dealt)
+            {
+                const EdgeList &part = buckets[b];
+                for (std::size_t i = 0; i < part.size(); ++i)
+                    bucket.push_back(part.from[i], part.to[i], part.weight[i], 0);
+                buckets[b] = EdgeList();
+            }
+
+            std::vector<int> order(bucket.size());
+            std::iota(order.begin(), order.end(), 0);
+            auto key = [&bucket](int i)
+            {
+                return std::make_pair(std::min(bucket.from[i], bucket.to[i]), std::max(bucket.from[i], bucket.to[i]));
+            };
+            std::sort(order.begin(), order.end(), [&](int a, int c)
+                      { return key(a) != key(c) ? key(a) < key(c) : bucket.weight[a] < bucket.weight[c]; });
+            for (std::size_t k = 0; k < order.size(); ++k)
+            {
+                int i = order[k];
+                if (k == 0 || key(i) != key(order[k - 1]))
+                    chunk.edges.push_back(bucket.from[i], bucket.to[i], bucket.weight[i], 0);
+            } });
+    }
+}
+
+std::shared_ptr<Graph> importGraph(const std::string &path, GraphFormat format, std::string &error, unsigned threads,
+                                   bool collapseParallel)
+{
+    if (format == GraphFormat::Invalid)
+    {
+        error = "unsupported graph format";
+        return nullptr;
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error = "cannot open " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        error = "cannot stat " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return nullptr;
+    }
+    std::size_t length = info.st_size;
+    void *data = length ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        error = "cannot map " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    std::unique_ptr<void, std::function<void(void *)>> mapping(data, [length](void *p)
+                                                                { if (p) munmap(p, length); });
+
+    const char *begin = static_cast<const char *>(data);
+    const char *end = begin + length;
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    MetisHeader metis;
+    if (format == GraphFormat::Metis)
+    {
+        const char *body = parseMetisHeader(begin, end, metis, error);
+        if (!body)
+            return nullptr;
+        begin = body;
+    }
+
+    std::vector<Chunk> chunks = splitChunks(begin, end, threads);
+    if (format == GraphFormat::EdgeList)
+    {
+        forEachChunk(chunks, [fileBegin = static_cast<const char *>(data)](Chunk &chunk)
+                     { parseEdgeListChunk(chunk, fileBegin); });
+    }
+    else if (format == GraphFormat::Dimacs)
+    {
+        forEachChunk(chunks, [fileBegin = static_cast<const char *>(data)](Chunk &chunk)
+                     { parseDimacsChunk(chunk, fileBegin); });
+    }
+    else
+    {
+        forEachChunk(chunks, countMetisLines);
+        for (std::size_t i = 1; i < chunks.size(); ++i)
+            chunks[i].firstVertex = chunks[i - 1].firstVertex + chunks[i - 1].vertexLines;
+        forEachChunk(chunks, [&metis, fileBegin = static_cast<const char *>(data)](Chunk &chunk)
+                     { parseMetisChunk(chunk, metis, fileBegin); });
+    }
+
+    long long vertexCount = format == GraphFormat::Metis ? metis.vertices : 0;
+    for (const Chunk &chunk : chunks)
+    {
+        if (!chunk.error.empty())
+        {
+            error = path + ": " + chunk.error;
+            return nullptr;
+        }
+        vertexCount = std::max(vertexCount, std::max(chunk.maxVertex + 1, chunk.declaredVertices));
+    }
+    if (vertexCount > MAX_VERTEX_COUNT)
+    {
+        error = path + " has more vertices than this build supports";
+        return nullptr;
+    }
+
+    if (collapseParallel && chunks.size() > 0)
+        collapseParallelEdges(chunks);
+
+    // The chunks are copied into the graph in parallel too, and without the pair index of removals
+    std::vector<EdgeView> blocks;
+    blocks.reserve(chunks.size());
+    for (const Chunk &chunk : chunks)
+        blocks.push_back(chunk.edges.view());
+    auto graph = std::make_shared<Graph>(static_cast<int>(vertexCount));
+    if (!graph->addEdgeBlocks(blocks, threads))
+    {
+        error = path + " has arcs to vertices beyond the declared vertex count";
+        return nullptr;
+    }
+    return graph;
+}
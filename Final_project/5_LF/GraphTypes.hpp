@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Widths of the vertex indices and edge weights stored by Graph, the solvers, Tree and MSTResult.
+// They are chosen at compile time, e.g. make VERTEX_TYPE=std::uint16_t WEIGHT_TYPE=float
+// Supported: vertices std::uint16_t / std::uint32_t / std::int32_t, weights std::int32_t / std::int64_t / float.
+#ifndef MST_VERTEX_TYPE
+#define MST_VERTEX_TYPE std::int32_t
+#endif
+#ifndef MST_WEIGHT_TYPE
+#define MST_WEIGHT_TYPE std::int32_t
+#endif
+
+using VertexId = MST_VERTEX_TYPE;
+using Weight = MST_WEIGHT_TYPE;
+
+// Sums of weights (path lengths, total MST weight) are accumulated in a wider type, so they
+// can't overflow the way an int accumulator does on large graphs.
+using Distance = std::conditional_t<std::is_floating_point_v<Weight>, double, std::int64_t>;
+
+static_assert(std::is_integral_v<VertexId> && sizeof(VertexId) <= sizeof(std::int32_t),
+              "VertexId must be an integer type of at most 32 bits");
+static_assert(std::is_arithmetic_v<Weight>, "Weight must be an arithmetic type");
+
+// Largest vertex count the configured VertexId can index
+constexpr std::int64_t MAX_VERTEX_COUNT =
+    std::numeric_limits<VertexId>::max() < std::numeric_limits<std::int32_t>::max()
+        ? static_cast<std::int64_t>(std::numeric_limits<VertexId>::max()) + 1
+        : std::numeric_limits<std::int32_t>::max();
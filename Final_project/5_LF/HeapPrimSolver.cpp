@@ -0,0 +1,50 @@
+#include "HeapPrimSolver.hpp"
+
+EdgeList HeapPrimSolver::computeMSTEdges(const Graph &graph)
+{
+    AdjacencyView adj = graph.getAdjacency();
+    int vertexCount = graph.getVertexCount();
+
+    bestSlot.assign(vertexCount, -1);
+    bestFrom.assign(vertexCount, 0);
+    inTree.assign(vertexCount, 0);
+    heap.reset(vertexCount);
+    EdgeList mst;
+    mst.reserve(vertexCount > 0 ? vertexCount - 1 : 0);
+
+    auto relax = [&](int v)
+    {
+        for (int k = adj.offsets[v]; k < adj.offsets[v + 1]; ++k)
+        {
+            int to = adj.targets[k];
+            if (inTree[to])
+                continue;
+            Weight w = adj.weights[k];
+            if (!heap.contains(to))
+                heap.push(to, w);
+            else if (w < heap.key(to))
+                heap.decreaseKey(to, w);
+            else
+                continue;
+            bestSlot[to] = k;
+            bestFrom[to] = static_cast<VertexId>(v);
+        }
+    };
+
+    for (int root = 0; root < vertexCount; ++root)
+    {
+        if (inTree[root])
+            continue;
+        inTree[root] = 1;
+        relax(root);
+        while (!heap.empty())
+        {
+            int v = heap.pop();
+            inTree[v] = 1;
+            int k = bestSlot[v];
+            mst.push_back(bestFrom[v], static_cast<VertexId>(v), adj.weights[k], adj.ids[k]);
+            relax(v);
+        }
+    }
+    return mst;
+}
@@ -1,38 +1,29 @@
 #include "KruskalSolver.hpp"
-#include "Tree.hpp"
-#include "union_find.hpp"
 #include <algorithm>
+#include <numeric>
 
-MSTResult KruskalSolver::computeMST(
-    const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount)
+EdgeList KruskalSolver::computeMSTEdges(const Graph &graph)
 {
-    UnionFind uf(vertexCount);
-    std::vector<std::tuple<int, int, int, int>> mst;
-    auto sortedEdges = edges;
+    EdgeView edges = graph.getEdges();
+    uf.reset(graph.getVertexCount());
+    EdgeList mst;
+    mst.reserve(graph.getVertexCount() > 0 ? graph.getVertexCount() - 1 : 0);
 
-    // Sort edges by weight
-    std::sort(sortedEdges.begin(), sortedEdges.end(),
-              [](const auto &a, const auto &b)
-              { return std::get<2>(a) < std::get<2>(b); });
+    // Sort edge indices by weight instead of copying the edges themselves
+    order.resize(edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [weights = edges.weight](int a, int b)
+              { return weights[a] < weights[b]; });
 
     // Add edges if they don’t form a cycle
-    for (const auto &[from, to, weight, id] : sortedEdges)
+    for (int index : order)
     {
-        if (uf.unite(from, to))
+        if (uf.unite(edges.from[index], edges.to[index]))
         {
-            mst.emplace_back(from, to, weight, id);
+            mst.push_back(edges.from[index], edges.to[index], edges.weight[index], edges.id[index]);
         }
     }
 
-    // Calculate metrics using Tree
-    Tree mstTree(mst);
-
-    // Create and return the MSTResult, passing the shortest distance map
-    return MSTResult{
-        mst,
-        mstTree.calculateTotalWeight(),
-        mstTree.calculateLongestDistance(),
-        mstTree.calculateAverageDistance(),
-        mstTree.getShortestPathMatrix() 
-    };
+    return mst;
 }
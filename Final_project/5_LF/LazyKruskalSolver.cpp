@@ -0,0 +1,32 @@
+#include "LazyKruskalSolver.hpp"
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+EdgeList LazyKruskalSolver::computeMSTEdges(const Graph &graph)
+{
+    EdgeView edges = graph.getEdges();
+    uf.reset(graph.getVertexCount());
+    EdgeList mst;
+    mst.reserve(graph.getVertexCount() > 0 ? graph.getVertexCount() - 1 : 0);
+
+    // Min-heap of (weight, edge index): the weights sit next to the indices, so sifting reads no other array
+    heap.resize(edges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        heap[i] = {edges.weight[i], static_cast<int>(i)};
+    std::make_heap(heap.begin(), heap.end(), std::greater<>());
+
+    // Pop the lightest edge until a single tree is left
+    auto end = heap.end();
+    while (end != heap.begin() && uf.cc > 1)
+    {
+        std::pop_heap(heap.begin(), end, std::greater<>());
+        --end;
+        int index = end->second;
+        if (uf.unite(edges.from[index], edges.to[index]))
+            mst.push_back(edges.from[index], edges.to[index], edges.weight[index], edges.id[index]);
+    }
+
+    return mst;
+}
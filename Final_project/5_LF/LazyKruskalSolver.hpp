@@ -0,0 +1,20 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "union_find.hpp"
+
+// Kruskal's algorithm that never sorts: the edges are heapified in O(E) and popped lightest first
+// only until the forest spans the graph. A connected graph with random weights is spanned after
+// about (V ln V) / 2 of its edges, so only that prefix pays the O(log E) of a pop. Disconnected
+// graphs never span and have all their edges popped.
+class LazyKruskalSolver : public MSTSolver
+{
+public:
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    SparseUnionFind uf{0};
+    std::vector<std::pair<Weight, int>> heap; // (weight, edge index)
+};
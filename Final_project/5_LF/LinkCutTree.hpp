@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "GraphTypes.hpp"
+
+// Sleator-Tarjan link-cut trees over the nodes 0..n-1: a forest that supports linking two trees,
+// cutting an edge and finding the heaviest node on the path between two nodes, each in
+// O(log n) amortized. Every preferred path is a splay tree ordered by depth that keeps the
+// heaviest node of its subtree; reversal flags let any node become the root of its tree.
+class LinkCutTree
+{
+public:
+    // n single-node trees, all of the lowest Weight
+    explicit LinkCutTree(int n);
+
+    // Sets the weight of a node
+    void setValue(int node, Weight value);
+    Weight value(int node) const { return values[node]; }
+
+    // Adds the edge u - v between two different trees
+    void link(int u, int v);
+
+    // Removes the existing edge u - v
+    void cut(int u, int v);
+
+    // True if u and v are in the same tree
+    bool connected(int u, int v);
+
+    // Heaviest node on the path between two nodes of the same tree (any of them on ties)
+    int pathMax(int u, int v);
+
+private:
+    std::vector<int> left, right, parent; // Splay children, and the splay or path parent (-1 if none)
+    std::vector<char> reversed;           // Pending reversal of the subtree
+    std::vector<Weight> values;
+    std::vector<int> heaviest;            // Heaviest node of the splay subtree
+    std::vector<int> splayPath;           // Scratch for splay, kept to avoid reallocating it
+
+    bool isSplayRoot(int x) const;
+    void update(int x);
+    void push(int x);
+    void rotate(int x);
+    void splay(int x);
+    void access(int x);
+    void makeRoot(int x);
+    int findRoot(int x);
+};
@@ -5,7 +5,14 @@
 enum class MSTAlgorithmType
 {
     Prim,      // Prim's algorithm
+    HeapPrim,  // Prim's algorithm on an indexed 4-ary heap
+    PrimDense, // O(V^2) Prim on an adjacency matrix, for dense graphs
     Kruskal,   // Kruskal's algorithm
+    Boruvka,   // Borůvka's algorithm, parallel
+    FilterKruskal, // Kruskal's algorithm that filters out heavy edges before sorting them
+    RadixKruskal,  // Kruskal's algorithm with a radix sort of the weights
+    LazyKruskal,   // Kruskal's algorithm popping the edges from a heap until the forest spans the graph
+    Auto,      // Picks one of the algorithms above from the shape of the graph (see MSTCostModel)
     Invalid    // Invalid type, used for unsupported algorithms
 };
 
@@ -15,7 +22,49 @@ inline MSTAlgorithmType stringToAlgorithmType(const std::string &algorithm)
 {
     if (algorithm == "Prim")
         return MSTAlgorithmType::Prim;       
+    if (algorithm == "HeapPrim")
+        return MSTAlgorithmType::HeapPrim;
+    if (algorithm == "PrimDense")
+        return MSTAlgorithmType::PrimDense;
     if (algorithm == "Kruskal")
         return MSTAlgorithmType::Kruskal;    
+    if (algorithm == "Boruvka")
+        return MSTAlgorithmType::Boruvka;
+    if (algorithm == "FilterKruskal")
+        return MSTAlgorithmType::FilterKruskal;
+    if (algorithm == "RadixKruskal")
+        return MSTAlgorithmType::RadixKruskal;
+    if (algorithm == "LazyKruskal")
+        return MSTAlgorithmType::LazyKruskal;
+    if (algorithm == "Auto")
+        return MSTAlgorithmType::Auto;
     return MSTAlgorithmType::Invalid;        // Returns Invalid if input doesn't match known algorithms
 }
+
+// Inverse of stringToAlgorithmType, "Invalid" for the Invalid type
+inline std::string algorithmTypeToString(MSTAlgorithmType algorithmType)
+{
+    switch (algorithmType)
+    {
+    case MSTAlgorithmType::Prim:
+        return "Prim";
+    case MSTAlgorithmType::HeapPrim:
+        return "HeapPrim";
+    case MSTAlgorithmType::PrimDense:
+        return "PrimDense";
+    case MSTAlgorithmType::Kruskal:
+        return "Kruskal";
+    case MSTAlgorithmType::Boruvka:
+        return "Boruvka";
+    case MSTAlgorithmType::FilterKruskal:
+        return "FilterKruskal";
+    case MSTAlgorithmType::RadixKruskal:
+        return "RadixKruskal";
+    case MSTAlgorithmType::LazyKruskal:
+        return "LazyKruskal";
+    case MSTAlgorithmType::Auto:
+        return "Auto";
+    default:
+        return "Invalid";
+    }
+}
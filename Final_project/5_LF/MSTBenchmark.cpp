@@ -0,0 +1,153 @@
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "MSTFactory.hpp"
+
+// Random connected graph: a random spanning tree keeps it connected, the remaining edges are uniform
+static Graph randomGraph(int vertices, long long edges, int maxWeight)
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(1, maxWeight);
+    Graph graph(vertices);
+    graph.reserveEdges(edges);
+    for (int v = 1; v < vertices; ++v)
+        graph.addEdge(std::uniform_int_distribution<int>(0, v - 1)(random), v, weight(random));
+    for (long long e = vertices - 1; e < edges; ++e)
+        graph.addEdge(vertex(random), vertex(random), weight(random));
+    graph.getAdjacency(); // Build the CSR once, outside the timings
+    return graph;
+}
+
+// Best of 'repeats' runs of the solver's MST edge computation, in milliseconds
+static double timeSolver(MSTSolver &solver, const Graph &graph, int repeats, Distance &total)
+{
+    double best = 0;
+    for (int run = 0; run < repeats; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        EdgeList mst = solver.computeMSTEdges(graph);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 ? ms : std::min(best, ms);
+        total = mst.totalWeight();
+    }
+    return best;
+}
+
+// Times every solver on a set of sparse and dense graphs with narrow and wide weight ranges,
+// fits overhead + perUnit * work for each by least squares and writes the cost model to 'path'
+static int calibrate(const std::string &path)
+{
+    struct Sample
+    {
+        int vertices;
+        long long edges;
+        int maxWeight;
+    };
+    const std::vector<Sample> samples = {
+        {20000, 100000, 1000000}, {100000, 500000, 1000000}, {200000, 2000000, 1000000}, {200000, 2000000, 255},
+        {50000, 1000000, 65535}, {1000, 400000, 1000000}, {3000, 2000000, 1000000}, {4000, 4000000, 255}};
+
+    // (work, milliseconds) points of every solver
+    std::vector<std::vector<std::pair<double, double>>> points(MSTCostModel::ALGORITHM_COUNT);
+    for (const Sample &sample : samples)
+    {
+        Graph graph = randomGraph(sample.vertices, sample.edges, sample.maxWeight);
+        GraphShape shape = GraphShape::of(graph);
+        std::cout << sample.vertices << " vertices, " << sample.edges << " edges, weights up to " << sample.maxWeight << std::endl;
+        for (std::size_t i = 0; i < MSTCostModel::ALGORITHM_COUNT; ++i)
+        {
+            MSTAlgorithmType algorithmType = static_cast<MSTAlgorithmType>(i);
+            double work = MSTCostModel::work(algorithmType, shape);
+            auto solver = MSTFactory::createSolver(algorithmType);
+            if (!solver || work == std::numeric_limits<double>::infinity())
+                continue;
+            Distance total = 0;
+            double ms = timeSolver(*solver, graph, 2, total);
+            points[i].push_back({work, ms});
+            std::cout << "  " << algorithmTypeToString(algorithmType) << ": " << ms << " ms" << std::endl;
+        }
+    }
+
+    MSTCostModel model;
+    for (std::size_t i = 0; i < MSTCostModel::ALGORITHM_COUNT; ++i)
+    {
+        const auto &p = points[i];
+        if (p.empty())
+            continue;
+        double n = p.size(), sw = 0, st = 0, sww = 0, swt = 0;
+        for (auto [w, t] : p)
+        {
+            sw += w;
+            st += t;
+            sww += w * w;
+            swt += w * t;
+        }
+        MSTCostModel::Coefficients values;
+        double spread = n * sww - sw * sw;
+        if (spread > 0)
+        {
+            values.perUnit = (n * swt - sw * st) / spread;
+            values.overhead = (st - values.perUnit * sw) / n;
+        }
+        if (values.overhead < 0 || values.perUnit <= 0) // Fall back to a line through the origin
+        {
+            values.overhead = 0;
+            values.perUnit = sww > 0 ? swt / sww : 0;
+        }
+        model.set(static_cast<MSTAlgorithmType>(i), values);
+    }
+
+    std::string error;
+    if (!model.save(path, error))
+    {
+        std::cerr << "Save failed: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << path << std::endl;
+    return 0;
+}
+
+// Times the MST edge computation of several solvers on the same random connected graph, or
+// calibrates the cost model behind SolveMST Auto.
+// Usage: mst_benchmark <vertices> <edges> [repeats] [algorithm...]   (default: every algorithm)
+//        mst_benchmark --calibrate [config file]                     (default: mst_cost_model.conf)
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--calibrate")
+        return calibrate(argc > 2 ? argv[2] : MSTCostModel::DEFAULT_PATH);
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <vertices> <edges> [repeats] [algorithm...]\n"
+                  << "       " << argv[0] << " --calibrate [config file]" << std::endl;
+        return 1;
+    }
+    int vertices = std::stoi(argv[1]);
+    long long edges = std::stoll(argv[2]);
+    int repeats = argc > 3 ? std::stoi(argv[3]) : 3;
+    std::vector<std::string> algorithms(argv + std::min(argc, 4), argv + argc);
+    if (algorithms.empty())
+        algorithms = {"Prim", "HeapPrim", "PrimDense", "Kruskal", "FilterKruskal", "RadixKruskal", "LazyKruskal", "Boruvka", "Auto"};
+    if (vertices < 1 || vertices > MAX_VERTEX_COUNT || edges < vertices - 1 || repeats < 1)
+    {
+        std::cerr << "Need 1 <= vertices <= " << MAX_VERTEX_COUNT << ", edges >= vertices - 1 and repeats >= 1" << std::endl;
+        return 1;
+    }
+
+    Graph graph = randomGraph(vertices, edges, 1000000);
+    std::cout << "Graph with " << vertices << " vertices and " << edges << " edges, best of " << repeats << " runs" << std::endl;
+    for (const std::string &name : algorithms)
+    {
+        auto solver = MSTFactory::createSolver(stringToAlgorithmType(name), graph);
+        if (!solver)
+            continue;
+
+        Distance total = 0;
+        double best = timeSolver(*solver, graph, repeats, total);
+        std::cout << name << ": " << best << " ms, MST weight " << total << std::endl;
+    }
+    return 0;
+}
@@ -1,14 +1,56 @@
 #pragma once
 
 #include "MSTSolver.hpp"
+#include "MSTMetrics.hpp"
 #include "MSTResult.hpp"
+#include "Graph.hpp"
 #include <memory>
-#include <vector>
-#include <tuple>
+#include <type_traits>
+#include <utility>
 
-// MSTContext manages the execution of a selected MST algorithm.
-// The strategy pattern is employed here, allowing dynamic switching of the solver strategy.
+// MSTContext manages the execution of an MST algorithm and computes the metrics chosen by a
+// MetricsPolicy (see MSTMetrics.hpp). This primary template fixes both at compile time: the solver
+// is a member of its concrete type and is called directly instead of through the vtable, so the
+// solve and the metrics are compiled together, and the metrics the policy leaves out are not
+// compiled at all. 'Metrics' is only the default policy: a solve can name another one, so a
+// single context (and the working arrays of its solver) serves every metrics selection.
+// MSTFactory::solve picks the instantiation from a runtime algorithm type and metrics selection.
+// MSTContext<MSTSolver> below is the runtime strategy.
+template <typename Solver, typename Metrics = AllMetrics>
 class MSTContext
+{
+    static_assert(std::is_base_of_v<MSTSolver, Solver>, "MSTContext needs an MSTSolver");
+
+private:
+    Solver solver; // Keeps its working arrays from one solve to the next
+
+public:
+    MSTContext() = default;
+    // Constructs the solver in place from its constructor arguments, e.g. a thread count: the
+    // solvers holding atomics cannot be moved into the context
+    template <typename... Args>
+    explicit MSTContext(std::in_place_t, Args &&...args) : solver(std::forward<Args>(args)...) {}
+
+    // Computes the MST and the metrics of the policy; the others are left empty in the MSTResult
+    template <typename Policy = Metrics>
+    MSTResult computeMST(const Graph &graph)
+    {
+        return Policy::measure(computeMSTEdges(graph), graph.getVertexCount());
+    }
+
+    // Computes the MST edges only, e.g. of a relabeled copy whose metrics are measured on the original
+    EdgeList computeMSTEdges(const Graph &graph)
+    {
+        return solver.Solver::computeMSTEdges(graph);
+    }
+
+    const Solver &getSolver() const { return solver; }
+};
+
+// The strategy pattern, for when the solver is only known at run time: the solver strategy can
+// be switched dynamically, and every solve goes through the virtual computeMSTEdges.
+template <typename Metrics>
+class MSTContext<MSTSolver, Metrics>
 {
 private:
     std::unique_ptr<MSTSolver> solver; // Pointer to the current MST solver strategy
@@ -20,14 +62,14 @@ public:
         solver = std::move(newSolver);
     }
 
-    // Computes the MST along with additional metrics using the current solver strategy.
-    // Inputs: list of edges and the vertex count.
+    // Computes the MST along with the metrics of the policy using the current solver strategy.
+    // Input: the graph to solve.
     // Output: MSTResult containing the MST edges and metrics.
-    MSTResult computeMST(const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount)
+    MSTResult computeMST(const Graph &graph)
     {
         if (solver)
         {
-            return solver->computeMST(edges, vertexCount); // Delegates MST computation to the solver
+            return Metrics::measure(solver->computeMSTEdges(graph), graph.getVertexCount()); // Delegates MST computation to the solver
         }
         return {}; // Returns an empty MSTResult if no solver is set
     }
@@ -2,9 +2,20 @@
 
 #include <memory>
 #include "MSTSolver.hpp"
+#include "MSTContext.hpp"
+#include "MSTMetrics.hpp"
 #include "PrimSolver.hpp"
+#include "HeapPrimSolver.hpp"
+#include "PrimDenseSolver.hpp"
 #include "KruskalSolver.hpp"
+#include "BoruvkaSolver.hpp"
+#include "FilterKruskalSolver.hpp"
+#include "RadixKruskalSolver.hpp"
+#include "LazyKruskalSolver.hpp"
+#include "ReorderingSolver.hpp"
+#include "ComponentSolver.hpp"
 #include "MSTAlgorithmType.hpp"
+#include "MSTCostModel.hpp"
 #include <iostream>
 
 // MSTFactory is a factory class responsible for creating instances of MSTSolver
@@ -14,19 +25,197 @@ class MSTFactory
 {
 public:
     // Static method that creates and returns a unique pointer to an MSTSolver.
-    static std::unique_ptr<MSTSolver> createSolver(MSTAlgorithmType algorithmType)
+    // With an ordering other than None, the solver runs on a graph relabeled in that order.
+    static std::unique_ptr<MSTSolver> createSolver(MSTAlgorithmType algorithmType,
+                                                   VertexOrdering ordering = VertexOrdering::None)
+    {
+        if (ordering == VertexOrdering::Invalid)
+        {
+            std::cout << "Invalid vertex ordering\n";
+            return nullptr;
+        }
+        if (ordering != VertexOrdering::None)
+        {
+            auto solver = createSolver(algorithmType);
+            if (!solver)
+                return nullptr;
+            std::cout << "Reordering vertices before solving\n";
+            return std::make_unique<ReorderingSolver>(std::move(solver), ordering);
+        }
+
+        if (algorithmType == MSTAlgorithmType::Auto)
+        {
+            std::cout << "Auto selection needs the graph\n";
+            return nullptr;
+        }
+        auto solver = newSolver(algorithmType);
+        if (!solver)
+        {
+            std::cout << "Invalid algorithm type\n";
+            return nullptr; // Return nullptr if the algorithm type is not supported
+        }
+        std::cout << "Creating " << algorithmTypeToString(algorithmType) << " Solver\n";
+        return solver;
+    }
+
+    // Same as above for a solver that will run on 'graph'. Auto is resolved here to the solver
+    // the host's cost model predicts to be fastest for the shape of the graph.
+    static std::unique_ptr<MSTSolver> createSolver(MSTAlgorithmType algorithmType, const Graph &graph,
+                                                   VertexOrdering ordering = VertexOrdering::None)
+    {
+        if (algorithmType == MSTAlgorithmType::Auto)
+        {
+            GraphShape shape = GraphShape::of(graph);
+            algorithmType = MSTCostModel::host().choose(shape);
+            std::cout << "Auto selected " << algorithmTypeToString(algorithmType) << " for " << shape.vertices
+                      << " vertices, " << shape.edges << " edges, density " << shape.density
+                      << ", weight range " << shape.weightRange << "\n";
+        }
+        auto solver = createSolver(algorithmType, ordering);
+        if (!solver)
+            return nullptr;
+        return splitComponents(std::move(solver), algorithmType);
+    }
+
+    // The algorithm that solves 'graph' for a requested type: Auto is resolved with the host's
+    // cost model, every other type is returned as is. Prints nothing.
+    static MSTAlgorithmType resolve(MSTAlgorithmType algorithmType, const Graph &graph)
+    {
+        if (algorithmType != MSTAlgorithmType::Auto)
+            return algorithmType;
+        return MSTCostModel::host().choose(GraphShape::of(graph));
+    }
+
+    // Solves 'graph' with a concrete algorithm type, computing only the selected metrics. The runtime
+    // choice is mapped to the calling thread's MSTContext of that algorithm, which lives as long as
+    // the thread: its working arrays only ever grow, so a thread that keeps solving graphs of similar
+    // size allocates nothing in the solver but the MST it returns. There is one context per algorithm
+    // and thread, shared by all the metrics selections and orderings; with an ordering, it solves the
+    // thread's relabeled copy (see solveReordered). Prints nothing; nullptr for Auto (see resolve)
+    // and for an invalid algorithm type, ordering or metrics selection.
+    static std::shared_ptr<const MSTResult> solve(MSTAlgorithmType algorithmType, MSTMetrics metrics, const Graph &graph,
+                                                  VertexOrdering ordering = VertexOrdering::None)
+    {
+        switch (metrics)
+        {
+        case MSTMetrics::All:
+            return solveWith<AllMetrics>(algorithmType, graph, ordering);
+        case MSTMetrics::Weight:
+            return solveWith<WeightMetrics>(algorithmType, graph, ordering);
+        case MSTMetrics::Components:
+            return solveWith<ComponentMetrics>(algorithmType, graph, ordering);
+        case MSTMetrics::Distances:
+            return solveWith<DistanceMetrics>(algorithmType, graph, ordering);
+        default:
+            return nullptr;
+        }
+    }
+
+    // Builds the MSTResult of MST edges that are already known with only the selected metrics;
+    // the runtime counterpart of MetricsPolicy::measure. An invalid selection gets all the metrics.
+    static MSTResult measure(EdgeList mst, int vertexCount, MSTMetrics metrics)
+    {
+        switch (metrics)
+        {
+        case MSTMetrics::Weight:
+            return WeightMetrics::measure(std::move(mst), vertexCount);
+        case MSTMetrics::Components:
+            return ComponentMetrics::measure(std::move(mst), vertexCount);
+        case MSTMetrics::Distances:
+            return DistanceMetrics::measure(std::move(mst), vertexCount);
+        default:
+            return AllMetrics::measure(std::move(mst), vertexCount);
+        }
+    }
+
+    // The compile-time context solveOn keeps per thread for an algorithm; the metrics policy is
+    // given per solve. Its solver still splits fragmented graphs so their components are solved
+    // in parallel.
+    template <typename Solver>
+    using StaticContext = MSTContext<ComponentSplit<Solver>>;
+
+private:
+    template <typename Metrics>
+    static std::shared_ptr<const MSTResult> solveWith(MSTAlgorithmType algorithmType, const Graph &graph, VertexOrdering ordering)
+    {
+        if (ordering == VertexOrdering::Invalid)
+            return nullptr;
+
+        switch (algorithmType)
+        {
+        case MSTAlgorithmType::Prim:
+            return solveOn<PrimSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::HeapPrim:
+            return solveOn<HeapPrimSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::PrimDense:
+            return solveOn<PrimDenseSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::Kruskal:
+            return solveOn<KruskalSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::Boruvka:
+            return solveOn<BoruvkaSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::FilterKruskal:
+            return solveOn<FilterKruskalSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::RadixKruskal:
+            return solveOn<RadixKruskalSolver, Metrics>(graph, ordering);
+        case MSTAlgorithmType::LazyKruskal:
+            return solveOn<LazyKruskalSolver, Metrics>(graph, ordering);
+        default:
+            return nullptr;
+        }
+    }
+
+    // The calling thread's context of an algorithm
+    template <typename Solver>
+    static StaticContext<Solver> &threadContext()
+    {
+        static thread_local StaticContext<Solver> context;
+        return context;
+    }
+
+    // Solves on the calling thread's context of the algorithm, measuring the metrics of the policy.
+    // The metrics of a reordered solve are measured on the original graph.
+    template <typename Solver, typename Metrics>
+    static std::shared_ptr<const MSTResult> solveOn(const Graph &graph, VertexOrdering ordering)
+    {
+        StaticContext<Solver> &context = threadContext<Solver>();
+        if (ordering == VertexOrdering::None)
+            return std::make_shared<const MSTResult>(context.template computeMST<Metrics>(graph));
+        EdgeList mst = solveReordered(graph, ordering, [&context](const Graph &relabeled)
+                                      { return context.computeMSTEdges(relabeled); });
+        return std::make_shared<const MSTResult>(Metrics::measure(std::move(mst), graph.getVertexCount()));
+    }
+
+    // Fragmented graphs have their components solved in parallel, one single-threaded solver per batch
+    static std::unique_ptr<MSTSolver> splitComponents(std::unique_ptr<MSTSolver> solver, MSTAlgorithmType algorithmType)
+    {
+        return std::make_unique<ComponentSolver>(std::move(solver), [algorithmType]()
+                                                 { return newSolver(algorithmType, 1); });
+    }
+
+    // The solver of a concrete algorithm type, nullptr for Auto and Invalid.
+    // threads = 0 lets the parallel solvers pick their thread count.
+    static std::unique_ptr<MSTSolver> newSolver(MSTAlgorithmType algorithmType, unsigned threads = 0)
     {
         switch (algorithmType)
         {
         case MSTAlgorithmType::Prim:
-            std::cout << "Creating Prim Solver\n";
             return std::make_unique<PrimSolver>();
+        case MSTAlgorithmType::HeapPrim:
+            return std::make_unique<HeapPrimSolver>();
+        case MSTAlgorithmType::PrimDense:
+            return std::make_unique<PrimDenseSolver>();
         case MSTAlgorithmType::Kruskal:
-            std::cout << "Creating Kruskal Solver\n";
             return std::make_unique<KruskalSolver>();
+        case MSTAlgorithmType::Boruvka:
+            return std::make_unique<BoruvkaSolver>(threads);
+        case MSTAlgorithmType::FilterKruskal:
+            return std::make_unique<FilterKruskalSolver>(threads);
+        case MSTAlgorithmType::RadixKruskal:
+            return std::make_unique<RadixKruskalSolver>(threads);
+        case MSTAlgorithmType::LazyKruskal:
+            return std::make_unique<LazyKruskalSolver>();
         default:
-            std::cout << "Invalid algorithm type\n";
-            return nullptr; // Return nullptr if the algorithm type is not supported
+            return nullptr;
         }
     }
 };
@@ -0,0 +1,89 @@
+#include "MSTResultCache.hpp"
+#include <algorithm>
+#include <iterator>
+
+std::shared_ptr<const MSTResult> MSTResultCache::find(int client, std::uint64_t graphVersion, MSTAlgorithmType algorithm,
+                                                      MSTMetrics metrics)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(Key{client, graphVersion, algorithm, metrics});
+    if (it == index.end())
+        return nullptr;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->result;
+}
+
+template <typename Predicate>
+void MSTResultCache::eraseIf(int client, Predicate drop)
+{
+    auto found = byClient.find(client);
+    if (found == byClient.end())
+        return;
+    // erase() reorders the client's list, so work on a copy of it
+    std::vector<std::list<Entry>::iterator> own = found->second;
+    for (auto it : own)
+        if (drop(it->key))
+            erase(it);
+}
+
+void MSTResultCache::insert(int client, std::uint64_t graphVersion, MSTAlgorithmType algorithm, MSTMetrics metrics,
+                            std::shared_ptr<const MSTResult> result)
+{
+    std::size_t bytes = footprint(*result);
+    std::lock_guard<std::mutex> lock(mutex);
+    Key key{client, graphVersion, algorithm, metrics};
+
+    // Drop the same key and the client's other graph versions, which can't be asked for again
+    eraseIf(client, [&key](const Key &cached)
+            { return cached.graphVersion != key.graphVersion || cached == key; });
+    if (bytes > budget)
+        return;
+
+    entries.push_front(Entry{key, std::move(result), bytes});
+    index[key] = entries.begin();
+    byClient[client].push_back(entries.begin());
+    used += bytes;
+    while (used > budget)
+        erase(std::prev(entries.end()));
+}
+
+void MSTResultCache::eraseClient(int client)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    eraseIf(client, [](const Key &)
+            { return true; });
+}
+
+std::size_t MSTResultCache::usedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return used;
+}
+
+std::size_t MSTResultCache::footprint(const MSTResult &result)
+{
+    // Hash map nodes hold the pair, a next pointer and the cached hash; every node also has a bucket pointer
+    constexpr std::size_t DISTANCE_ENTRY = sizeof(std::pair<const int, Distance>) + 3 * sizeof(void *);
+    constexpr std::size_t ROW_ENTRY = sizeof(std::pair<const int, std::unordered_map<int, Distance>>) + 3 * sizeof(void *);
+
+    std::size_t bytes = sizeof(MSTResult);
+    bytes += result.mstEdges.size() * (2 * sizeof(VertexId) + sizeof(Weight) + sizeof(int));
+    bytes += result.components.size() * sizeof(ComponentStats);
+    for (const auto &row : result.shortestDistances)
+        bytes += ROW_ENTRY + row.second.size() * DISTANCE_ENTRY;
+    return bytes;
+}
+
+void MSTResultCache::erase(std::list<Entry>::iterator it)
+{
+    auto client = byClient.find(it->key.client);
+    std::vector<std::list<Entry>::iterator> &own = client->second;
+    *std::find(own.begin(), own.end(), it) = own.back();
+    own.pop_back();
+    if (own.empty())
+        byClient.erase(client);
+
+    used -= it->bytes;
+    index.erase(it->key);
+    entries.erase(it);
+}
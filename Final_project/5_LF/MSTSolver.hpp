@@ -1,13 +1,29 @@
 #pragma once
-#include <vector>
-#include <tuple>
+#include "Graph.hpp"
 #include "MSTResult.hpp"
+#include "MSTMetrics.hpp"
 
+// A solver may keep its working arrays as members and only ever grow them, so one that is reused
+// for graphs of similar size allocates nothing but the MST it returns (see MSTFactory::solve).
+// A solver object is therefore not safe to use from two threads at once.
 class MSTSolver
 {
 public:
     virtual ~MSTSolver() = default;
 
-    // Change return type to MSTResult
-    virtual MSTResult computeMST(const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount) = 0;
-};
+    // Computes the MST edges of the graph, reading its edge list or CSR adjacency in place
+    virtual EdgeList computeMSTEdges(const Graph &graph) = 0;
+
+    // Computes the MST and its metrics (total weight and distances, using Tree)
+    virtual MSTResult computeMST(const Graph &graph)
+    {
+        return measureMST(computeMSTEdges(graph), graph.getVertexCount());
+    }
+
+    // Builds the MSTResult of MST edges that are already known, for a graph of 'vertexCount' vertices,
+    // with all the metrics (see MetricsPolicy to compute only some of them)
+    static MSTResult measureMST(EdgeList mst, int vertexCount)
+    {
+        return AllMetrics::measure(std::move(mst), vertexCount);
+    }
+};
\ No newline at end of file
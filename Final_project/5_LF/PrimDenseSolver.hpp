@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+
+// Largest vertex count whose adjacency matrix (a weight and an edge ID per vertex pair) fits in 'budget' bytes
+constexpr int matrixVertexLimit(std::size_t budget)
+{
+    std::size_t pairs = budget / (sizeof(Weight) + sizeof(int)), n = 0;
+    while ((n + 1) * (n + 1) <= pairs)
+        ++n;
+    return static_cast<int>(n);
+}
+
+// Classic O(V^2) Prim for dense graphs: no heap, every step scans the key array of all vertices
+// with a branchless min-reduction and relaxes one row of an adjacency matrix of the graph. The
+// matrix is built for the solve and freed when it ends. Disconnected graphs get a spanning forest.
+// Graphs with more than MAX_VERTICES vertices are solved with HeapPrimSolver instead, as their
+// matrix would exceed MATRIX_BUDGET_BYTES.
+class PrimDenseSolver : public MSTSolver
+{
+public:
+    static constexpr std::size_t MATRIX_BUDGET_BYTES = std::size_t(128) << 20;
+    static constexpr int MAX_VERTICES = matrixVertexLimit(MATRIX_BUDGET_BYTES); // 4096 with 32-bit weights
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    std::vector<Weight> key;
+    std::vector<VertexId> parent;
+    std::vector<int> edgeId;
+    std::vector<char> done;
+    std::unique_ptr<MSTSolver> sparseSolver; // Solves the graphs above MAX_VERTICES, created on first use
+};
@@ -1,78 +1,61 @@
 #include "PrimSolver.hpp"
-#include "Tree.hpp"
-#include <limits>
 #include <vector>
 #include <set>
 
-constexpr int INF = std::numeric_limits<int>::max();
-
-struct Edge
-{
-    int weight = INF, from = -1, to = -1, id;
-
-    bool operator<(const Edge &other) const
-    {
-        return std::make_pair(weight, to) < std::make_pair(other.weight, other.to);
-    }
-
-    Edge() = default;
-    Edge(int w, int from, int to, int id) : weight(w), from(from), to(to), id(id) {}
-};
-
-// Integrate Tree to provide MST metrics along with MST edges
-MSTResult PrimSolver::computeMST(const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount)
+// Grows a tree from every vertex not reached by the earlier ones, so a disconnected graph
+// gets its minimum spanning forest. The metrics are added by MSTSolver::computeMST.
+EdgeList PrimSolver::computeMSTEdges(const Graph &graph)
 {
-    // Step 1: Build adjacency list
-    std::vector<std::vector<Edge>> adj(vertexCount);
-    for (const auto &[from, to, weight, id] : edges)
-    {
-        adj[from].emplace_back(Edge(weight, from, to, id));
-    }
+    // Step 1: Use the graph's CSR adjacency (built once, shared by all solves)
+    AdjacencyView adj = graph.getAdjacency();
+    int vertexCount = graph.getVertexCount();
 
-    // Step 2: Initialize Prim's algorithm data structures
-    std::vector<Edge> minEdge(vertexCount, {INF, -1, -1, -1});
-    minEdge[0].weight = 0;
+    // Step 2: Initialize Prim's algorithm data structures, reusing the buffers of earlier solves
+    minEdge.assign(vertexCount, Edge());
+    selected.assign(vertexCount, false);
     std::set<Edge> q;
-    q.insert({0, 0, 0, -1});
-    std::vector<bool> selected(vertexCount, false);
-    std::vector<std::tuple<int, int, int, int>> mst;
+    EdgeList mst;
+    mst.reserve(vertexCount > 0 ? vertexCount - 1 : 0);
 
-    // Step 3: Prim's algorithm loop
-    while (!q.empty())
+    // Step 3: Prim's algorithm loop, once per component
+    for (int root = 0; root < vertexCount; ++root)
     {
-        int v = q.begin()->to;
-        Edge currentEdge = *q.begin();
-        q.erase(q.begin());
-
-        if (selected[v])
+        if (selected[root])
             continue;
+        minEdge[root].weight = 0;
+        q.insert({0, static_cast<VertexId>(root), static_cast<VertexId>(root), -1});
 
-        selected[v] = true;
-
-        if (currentEdge.from != currentEdge.to)
+        while (!q.empty())
         {
-            mst.emplace_back(currentEdge.from, v, currentEdge.weight, currentEdge.id);
-        }
+            int v = q.begin()->to;
+            Edge currentEdge = *q.begin();
+            q.erase(q.begin());
 
-        for (const auto &e : adj[v])
-        {
-            if (!selected[e.to] && e.weight < minEdge[e.to].weight)
+            if (selected[v])
+                continue;
+
+            selected[v] = true;
+
+            if (currentEdge.from != currentEdge.to)
             {
-                q.erase(minEdge[e.to]);
-                minEdge[e.to] = e;
-                q.insert(e);
+                mst.push_back(currentEdge.from, v, currentEdge.weight, currentEdge.id);
+            }
+
+            // A vertex without a candidate edge yet (id -1) takes any edge, even one of the largest weight
+            for (int k = adj.offsets[v]; k < adj.offsets[v + 1]; ++k)
+            {
+                int to = adj.targets[k];
+                bool hasCandidate = minEdge[to].id >= 0;
+                if (!selected[to] && (!hasCandidate || adj.weights[k] < minEdge[to].weight))
+                {
+                    if (hasCandidate)
+                        q.erase(minEdge[to]);
+                    minEdge[to] = Edge(adj.weights[k], v, to, adj.ids[k]);
+                    q.insert(minEdge[to]);
+                }
             }
         }
     }
 
-    // Calculate metrics using Tree
-    Tree mstTree(mst);
-
-    // Return MSTResult, including precomputed shortest distances
-    return MSTResult{
-        mst,
-        mstTree.calculateTotalWeight(),
-        mstTree.calculateLongestDistance(),
-        mstTree.calculateAverageDistance(),
-        mstTree.getShortestPathMatrix()};
+    return mst;
 }
@@ -1,9 +1,34 @@
 #pragma once
+#include <limits>
+#include <utility>
+#include <vector>
 #include "MSTSolver.hpp"
 #include "MSTResult.hpp"
 
+// Prim's algorithm on a std::set of candidate edges: an improved edge to a vertex replaces the
+// old one in the set. The per-vertex arrays are kept from one solve to the next; the set still
+// allocates a node per insert.
 class PrimSolver : public MSTSolver
 {
 public:
-    MSTResult computeMST(const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount) override;
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    struct Edge
+    {
+        Weight weight = std::numeric_limits<Weight>::max();
+        VertexId from = 0, to = 0;
+        int id = -1; // -1 until the vertex has a candidate edge: any weight, even the largest, is one
+
+        bool operator<(const Edge &other) const
+        {
+            return std::make_pair(weight, to) < std::make_pair(other.weight, other.to);
+        }
+
+        Edge() = default;
+        Edge(Weight w, VertexId from, VertexId to, int id) : weight(w), from(from), to(to), id(id) {}
+    };
+
+    std::vector<Edge> minEdge;
+    std::vector<bool> selected;
 };
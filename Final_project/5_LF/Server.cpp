@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <algorithm>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <signal.h>
@@ -17,6 +18,10 @@ std::atomic<bool> isRunning{true};
 std::atomic<int> clientCount{0}; // Counter to track connected clients
 
 #define NUM_THREADS 4 // Number of threads for LFP
+
+// Binary bulk edge command: the bytes "AddEdges", an int32 edge count, then count (from, to, weight) int32 triples
+static const char BULK_EDGES_COMMAND[] = "AddEdges";
+static const int BULK_EDGES_COMMAND_LENGTH = sizeof(BULK_EDGES_COMMAND) - 1;
 std::unique_ptr<LFP> lfp;
 
 std::mutex coutMutex; // Ensure this is global or static within the file
@@ -149,6 +154,34 @@ void Server::closeAllConnections()
     }
 }
 
+// Reads exactly 'length' bytes from the socket, returns false if the connection closed first
+static bool readFully(int socket, char *data, size_t length)
+{
+    size_t total = 0;
+    while (total < length)
+    {
+        ssize_t bytes = read(socket, data + total, length - total);
+        if (bytes <= 0)
+            return false;
+        total += bytes;
+    }
+    return true;
+}
+
+// Reads and drops exactly 'length' bytes from the socket
+static bool skipFully(int socket, size_t length)
+{
+    char discarded[4096];
+    while (length > 0)
+    {
+        ssize_t bytes = read(socket, discarded, std::min(length, sizeof(discarded)));
+        if (bytes <= 0)
+            return false;
+        length -= bytes;
+    }
+    return true;
+}
+
 void Server::handleClient(int client_socket)
 {
     char buffer[1024];
@@ -157,15 +190,75 @@ void Server::handleClient(int client_socket)
     while ((bytes_read = read(client_socket, buffer, sizeof(buffer) - 1)) > 0)
     {
         buffer[bytes_read] = '\0';
-        processRequest(client_socket, buffer);
+        std::string request(buffer, bytes_read);
+
+        // Binary blocks can't go through the text parser; whatever follows the block is a regular request
+        bool open = true;
+        while (open && request.compare(0, BULK_EDGES_COMMAND_LENGTH, BULK_EDGES_COMMAND) == 0)
+            open = receiveBulkEdges(client_socket, request);
+        if (!open)
+            break;
+
+        if (!request.empty())
+            processRequest(client_socket, request);
     }
 
     close(client_socket);
+    resultCache.eraseClient(client_socket);
     std::ostringstream oss;
     oss << "Client disconnected from FD: " << client_socket;
     threadSafePrint(oss);
 }
 
+// Completes an AddEdges block whose first bytes were already read into 'request', adds its edges
+// and leaves in 'request' the bytes received after the end of the block. A block of more than
+// MAX_BULK_EDGES edges is read and dropped, so the next command is still found where it starts.
+// Returns false if the connection must be closed: it broke, or the block has a negative edge
+// count and its end can't be found.
+bool Server::receiveBulkEdges(int client_socket, std::string &request)
+{
+    const size_t headerLength = BULK_EDGES_COMMAND_LENGTH + sizeof(int32_t);
+    size_t length = request.size();
+    std::vector<char> header(request.begin(), request.begin() + std::min(length, headerLength));
+    header.resize(headerLength);
+    if (length < headerLength && !readFully(client_socket, header.data() + length, headerLength - length))
+        return false;
+
+    int32_t count;
+    std::memcpy(&count, header.data() + BULK_EDGES_COMMAND_LENGTH, sizeof(count));
+    if (count < 0)
+    {
+        std::ostringstream oss;
+        oss << "Closing the connection of client " << client_socket << " after an AddEdges block with edge count " << count;
+        threadSafePrint(oss);
+        return false;
+    }
+
+    size_t payloadLength = 3 * static_cast<size_t>(count) * sizeof(int32_t);
+    size_t buffered = length > headerLength ? std::min(length - headerLength, payloadLength) : 0;
+    if (count > MAX_BULK_EDGES)
+    {
+        std::ostringstream oss;
+        oss << "Rejected AddEdges block of " << count << " edges from client " << client_socket
+            << ", the limit is " << MAX_BULK_EDGES;
+        threadSafePrint(oss);
+        if (!skipFully(client_socket, payloadLength - buffered))
+            return false;
+    }
+    else
+    {
+        // Copy the part of the payload that arrived with the header, then read the rest
+        std::vector<int32_t> triples(3 * static_cast<size_t>(count));
+        std::memcpy(triples.data(), request.data() + headerLength, buffered);
+        if (!readFully(client_socket, reinterpret_cast<char *>(triples.data()) + buffered, payloadLength - buffered))
+            return false;
+        addEdges(client_socket, triples);
+    }
+
+    request.erase(0, std::min(length, headerLength + buffered));
+    return true;
+}
+
 void Server::processRequest(int client_socket, const std::string &request)
 {
     std::istringstream iss(request);
@@ -174,13 +267,14 @@ void Server::processRequest(int client_socket, const std::string &request)
 
     if (command == "NewGraph")
     {
-        int n;
+        long long n;
         iss >> n;
         addGraph(client_socket, n);
     }
     else if (command == "AddEdge")
     {
-        int i, j, weight;
+        int i, j;
+        Weight weight;
         iss >> i >> j >> weight;
         addEdge(client_socket, i, j, weight);
     }
@@ -190,12 +284,40 @@ void Server::processRequest(int client_socket, const std::string &request)
         iss >> i >> j;
         removeEdge(client_socket, i, j);
     }
+    else if (command == "LoadGraph")
+    {
+        std::string path;
+        iss >> path;
+        loadGraph(client_socket, path);
+    }
+    else if (command == "SaveGraph")
+    {
+        std::string path;
+        iss >> path;
+        saveGraph(client_socket, path);
+    }
+    else if (command == "ImportGraph")
+    {
+        std::string path, format, option;
+        iss >> path >> format >> option;
+        importGraph(client_socket, path, format, option == "collapse");
+    }
     else if (command == "SolveMST")
     {
-        std::string algorithm;
+        // SolveMST <algorithm> [BFS|RCM] [All|Weight|Components|Distances]
+        std::string algorithm, option;
         iss >> algorithm;
+        VertexOrdering ordering = VertexOrdering::None;
+        MSTMetrics metrics = MSTMetrics::All;
+        while (iss >> option)
+        {
+            if (stringToMSTMetrics(option) != MSTMetrics::Invalid)
+                metrics = stringToMSTMetrics(option);
+            else
+                ordering = stringToVertexOrdering(option);
+        }
         MSTAlgorithmType algoType = stringToAlgorithmType(algorithm);
-        solveMSTWithLF(client_socket, algoType);
+        solveMSTWithLF(client_socket, algoType, ordering, metrics);
     }
     else
     {
@@ -205,80 +327,363 @@ void Server::processRequest(int client_socket, const std::string &request)
     }
 }
 
-void Server::addGraph(int client_id, int n)
+// Returns the client's graph ready for an in-place edit. A version that is still pinned by a
+// running solve or save is never modified: it is copied first and the copy becomes the current
+// version, with no pins. Must be called with clientsGraphsMutex held.
+Graph &Server::editableGraph(int client_id)
+{
+    auto &graph = clients_graphs[client_id];
+    if (!graph)
+        graph = std::make_shared<Graph>();
+    else if (graphPins[client_id] > 0)
+    {
+        graph = std::make_shared<Graph>(*graph);
+        graphPins.erase(client_id);
+    }
+    return *graph;
+}
+
+// Returns the client's current graph version, or nullptr if it has none, pinned so it can be read
+// without holding the lock. The pin count, not the shared_ptr's use count, is what keeps edits from
+// modifying it in place: it is only changed under the lock. Must be called with clientsGraphsMutex held.
+std::shared_ptr<const Graph> Server::pinGraph(int client_id)
+{
+    auto it = clients_graphs.find(client_id);
+    if (it == clients_graphs.end() || !it->second)
+        return nullptr;
+    ++graphPins[client_id];
+    return it->second;
+}
+
+// Releases a pin taken by pinGraph. Once the version was copied or replaced, its pins are gone.
+void Server::releaseGraph(int client_id, const std::shared_ptr<const Graph> &graph)
 {
     std::lock_guard<std::mutex> lock(clientsGraphsMutex);
-    clients_graphs[client_id] = Graph(n);
+    auto it = clients_graphs.find(client_id);
+    if (graph && it != clients_graphs.end() && it->second == graph)
+        --graphPins[client_id];
+}
+
+// Feeds the last 'added' edges of the client's graph to its maintained MST, if it has one.
+// Must be called with clientsGraphsMutex held, right after the edges were added.
+void Server::updateMaintainedMST(int client_id, std::size_t added)
+{
+    auto it = maintainedMSTs.find(client_id);
+    if (it == maintainedMSTs.end())
+        return;
+
+    EdgeView edges = clients_graphs[client_id]->getEdges();
+    for (std::size_t i = edges.size() - added; i < edges.size(); ++i)
+        it->second->addEdge(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+}
+
+// Puts back a maintained MST that was updated outside the lock, on the pinned version 'graph'. It is
+// dropped if the graph has moved on meanwhile; the next SolveMST then builds a new one.
+void Server::reinstallMaintainedMST(int client_id, const std::shared_ptr<const Graph> &graph, std::unique_ptr<DynamicMST> dynamic)
+{
+    std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+    auto it = clients_graphs.find(client_id);
+    if (it != clients_graphs.end() && it->second == graph && !maintainedMSTs.count(client_id))
+        maintainedMSTs[client_id] = std::move(dynamic);
+}
+
+void Server::addGraph(int client_id, long long n)
+{
     std::ostringstream oss;
+    if (n < 0 || n > MAX_VERTEX_COUNT)
+    {
+        oss << "Rejected graph with " << n << " vertices for client " << client_id
+            << ", this build supports up to " << MAX_VERTEX_COUNT << " vertices";
+        threadSafePrint(oss);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+    clients_graphs[client_id] = std::make_shared<Graph>(static_cast<int>(n));
+    maintainedMSTs.erase(client_id);
+    graphPins.erase(client_id);
     oss << "New graph created with " << n << " vertices for client " << client_id;
     threadSafePrint(oss);
 }
 
-void Server::addEdge(int client_id, int i, int j, int weight)
+void Server::addEdge(int client_id, int i, int j, Weight weight)
 {
     std::lock_guard<std::mutex> lock(clientsGraphsMutex);
-    clients_graphs[client_id].addEdge(i, j, weight);
     std::ostringstream oss;
-    oss << "Added edge (" << i << ", " << j << ") with weight " << weight << " for client " << client_id;
+    if (editableGraph(client_id).addEdge(i, j, weight))
+    {
+        updateMaintainedMST(client_id, 1);
+        oss << "Added edge (" << i << ", " << j << ") with weight " << weight << " for client " << client_id;
+    }
+    else
+        oss << "Rejected edge (" << i << ", " << j << ") with out-of-range vertices for client " << client_id;
+    threadSafePrint(oss);
+}
+
+void Server::addEdges(int client_id, const std::vector<int32_t> &triples)
+{
+    // A block can hold millions of edges, each an O(log V) update of the maintained MST. Like the
+    // replacement search of removeEdge, those run outside the lock, on the MST taken out of
+    // maintainedMSTs and the pinned version holding the block.
+    size_t count = triples.size() / 3;
+    std::unique_ptr<DynamicMST> dynamic;
+    std::shared_ptr<const Graph> graph;
+    bool added;
+    {
+        std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        added = editableGraph(client_id).addEdges(triples.data(), count);
+        auto it = maintainedMSTs.find(client_id);
+        if (added && it != maintainedMSTs.end())
+        {
+            dynamic = std::move(it->second);
+            maintainedMSTs.erase(it);
+            graph = pinGraph(client_id);
+        }
+    }
+    if (dynamic)
+    {
+        EdgeView edges = graph->getEdges();
+        for (std::size_t i = edges.size() - count; i < edges.size(); ++i)
+            dynamic->addEdge(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+        reinstallMaintainedMST(client_id, graph, std::move(dynamic));
+        releaseGraph(client_id, graph);
+    }
+    std::ostringstream oss;
+    if (added)
+        oss << "Added " << count << " edges for client " << client_id;
+    else
+        oss << "Rejected block of " << count << " edges with out-of-range vertices for client " << client_id;
     threadSafePrint(oss);
 }
 
 void Server::removeEdge(int client_id, int i, int j)
 {
-    std::lock_guard<std::mutex> lock(clientsGraphsMutex);
-    clients_graphs[client_id].removeEdge(i, j);
+    // Removing a tree edge makes the maintained MST search for a replacement, and index the non-tree
+    // edges the first time. That runs outside the lock, on the MST taken out of maintainedMSTs and
+    // the pinned version it belongs to (see reinstallMaintainedMST).
+    std::unique_ptr<DynamicMST> dynamic;
+    std::shared_ptr<const Graph> graph;
+    std::vector<int> removed;
+    {
+        std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        removed = editableGraph(client_id).removeEdge(i, j);
+        auto it = maintainedMSTs.find(client_id);
+        if (it != maintainedMSTs.end())
+        {
+            if (!it->second->touchesForest(removed))
+                it->second->removeEdges(removed, *clients_graphs[client_id]);
+            else
+            {
+                dynamic = std::move(it->second);
+                maintainedMSTs.erase(it);
+                graph = pinGraph(client_id);
+            }
+        }
+    }
+    if (dynamic)
+    {
+        dynamic->removeEdges(removed, *graph);
+        reinstallMaintainedMST(client_id, graph, std::move(dynamic));
+        releaseGraph(client_id, graph);
+    }
     std::ostringstream oss;
     oss << "Removed edge (" << i << ", " << j << ") for client " << client_id;
     threadSafePrint(oss);
 }
 
-void Server::solveMSTWithLF(int client_socket, MSTAlgorithmType algoType)
+void Server::loadGraph(int client_id, const std::string &path)
 {
+    // Map and validate the file before taking the lock; attaching it is then O(1)
+    std::string error;
+    auto file = MappedGraphFile::open(path, error);
+    std::ostringstream oss;
+    if (!file)
+    {
+        oss << "Failed to load graph for client " << client_id << ": " << error;
+        threadSafePrint(oss);
+        return;
+    }
+
+    int vertices = file->vertexCount();
+    size_t edges = file->edges().size();
     {
         std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        clients_graphs[client_id] = std::make_shared<Graph>(Graph::fromMappedFile(std::move(file)));
+        maintainedMSTs.erase(client_id);
+        graphPins.erase(client_id);
+    }
+    oss << "Loaded graph " << path << " with " << vertices << " vertices and " << edges << " edges for client " << client_id;
+    threadSafePrint(oss);
+}
+
+void Server::importGraph(int client_id, const std::string &path, const std::string &format, bool collapseParallel)
+{
+    // Parse the text file on several threads before taking the lock, then install the new graph
+    std::string error;
+    auto graph = ::importGraph(path, stringToGraphFormat(format), error, 0, collapseParallel);
+    std::ostringstream oss;
+    if (!graph)
+    {
+        oss << "Failed to import graph for client " << client_id << ": " << error;
+        threadSafePrint(oss);
+        return;
+    }
 
-        auto it = clients_graphs.find(client_socket);
-        if (it == clients_graphs.end())
+    int vertices = graph->getVertexCount();
+    size_t edges = graph->getEdges().size();
+    {
+        std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        clients_graphs[client_id] = std::move(graph);
+        maintainedMSTs.erase(client_id);
+        graphPins.erase(client_id);
+    }
+    oss << "Imported " << format << " graph " << path << " with " << vertices << " vertices and " << edges << " edges for client " << client_id;
+    threadSafePrint(oss);
+}
+
+void Server::saveGraph(int client_id, const std::string &path)
+{
+    // Pin the current version and write it without holding the lock
+    std::shared_ptr<const Graph> graph;
+    {
+        std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        graph = pinGraph(client_id);
+    }
+    std::string error;
+    std::ostringstream oss;
+    if (graph && graph->save(path, error))
+        oss << "Saved graph of client " << client_id << " to " << path;
+    else
+        oss << "Failed to save graph of client " << client_id << ": " << error;
+    threadSafePrint(oss);
+    releaseGraph(client_id, graph);
+}
+
+void Server::solveMSTWithLF(int client_socket, MSTAlgorithmType algoType, VertexOrdering ordering, MSTMetrics metrics)
+{
+    // Pin the current version of the graph. Edits made meanwhile copy it instead of modifying it,
+    // so the solve below runs without holding clientsGraphsMutex. A result cached for this version,
+    // algorithm and metrics selection is sent as is; otherwise, if the graph was only edited since the last solve,
+    // its maintained MST is measured instead of solving the graph again.
+    std::shared_ptr<const Graph> graph;
+    std::shared_ptr<const MSTResult> cached;
+    EdgeList maintainedEdges;
+    bool maintained = false;
+    {
+        std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+        graph = pinGraph(client_socket);
+        if (graph)
+            cached = resultCache.find(client_socket, graph->getVersion(), algoType, metrics);
+        auto found = maintainedMSTs.find(client_socket);
+        if (!cached && found != maintainedMSTs.end())
+        {
+            maintained = true;
+            maintainedEdges = found->second->edges();
+        }
+    }
+    if (!graph)
+    {
+        std::ostringstream oss;
+        oss << "No graph found for client " << client_socket;
+        threadSafePrint(oss);
+        return;
+    }
+    if (algoType == MSTAlgorithmType::Invalid || ordering == VertexOrdering::Invalid)
+    {
+        std::ostringstream oss;
+        oss << "Invalid MST algorithm or vertex ordering requested";
+        threadSafePrint(oss);
+        releaseGraph(client_socket, graph);
+        return;
+    }
+
+    {
+        std::shared_ptr<const MSTResult> result = cached;
+        if (result)
         {
             std::ostringstream oss;
-            oss << "No graph found for client " << client_socket;
+            oss << "Reusing the cached MST of client " << client_socket;
             threadSafePrint(oss);
-            return;
         }
-
-        MSTFactory factory;
-        auto solver = factory.createSolver(algoType);
-        if (!solver)
+        else if (maintained)
         {
+            result = std::make_shared<const MSTResult>(MSTFactory::measure(std::move(maintainedEdges), graph->getVertexCount(), metrics));
             std::ostringstream oss;
-            oss << "Invalid MST algorithm requested";
+            oss << "Reusing the MST maintained across graph edits for client " << client_socket;
             threadSafePrint(oss);
-            return;
         }
+        else
+        {
+            // The algorithm and metrics select one of the compiled solver instantiations, kept per thread
+            // with its buffers from earlier solves
+            MSTAlgorithmType solverType = MSTFactory::resolve(algoType, *graph);
+            {
+                std::ostringstream oss;
+                oss << "Solving the MST of client " << client_socket << " with " << algorithmTypeToString(solverType);
+                threadSafePrint(oss);
+            }
+            result = MSTFactory::solve(solverType, metrics, *graph, ordering);
+            if (!result)
+            {
+                std::ostringstream oss;
+                oss << "Invalid MST algorithm or vertex ordering requested";
+                threadSafePrint(oss);
+                releaseGraph(client_socket, graph);
+                return;
+            }
 
-        auto graph = it->second;
-        MSTResult mst = solver->computeMST(graph.getEdges(), graph.getVertexCount());
+            // Start maintaining this MST, unless the graph was replaced or edited during the solve.
+            // The link-cut tree is built before taking the lock, which only swaps it in; the MST it
+            // replaces, if any, is freed after the lock is released.
+            auto dynamic = std::make_unique<DynamicMST>(graph->getVertexCount(), result->mstEdges);
+            std::lock_guard<std::mutex> lock(clientsGraphsMutex);
+            auto it = clients_graphs.find(client_socket);
+            if (it != clients_graphs.end() && it->second == graph)
+                std::swap(maintainedMSTs[client_socket], dynamic);
+        }
+        if (!cached)
+            resultCache.insert(client_socket, graph->getVersion(), algoType, metrics, result);
+        releaseGraph(client_socket, graph);
 
-        lfp->addTask([client_socket, mst]()
+        lfp->addTask([client_socket, result, metrics]()
                      {
+            const MSTResult &mst = *result;
             std::ostringstream response;
             response << "Client " << client_socket << " MST:\n";
 
-            for (const auto &[from, to, weight, id] : mst.mstEdges)
+            const EdgeList &edges = mst.mstEdges;
+            for (std::size_t i = 0; i < edges.size(); ++i)
             {
-                response << "Edge from " << from << " to " << to << " with weight " << weight << "\n";
+                response << "Edge from " << edges.from[i] << " to " << edges.to[i] << " with weight " << edges.weight[i] << "\n";
             }
 
+            // Only the metrics that were computed are reported
             response << "Total weight: " << mst.totalWeight << "\n";
-            response << "Average distance: " << mst.averageDistance << "\n";
-            response << "Longest distance: " << mst.longestDistance << "\n";
-            response << "Shortest paths in MST:\n";
-
-            for (const auto &row : mst.shortestDistances)
+            if (hasDistances(metrics))
             {
-                for (const auto &dist : row.second)
+                response << "Average distance: " << mst.averageDistance << "\n";
+                response << "Longest distance: " << mst.longestDistance << "\n";
+            }
+            if (hasComponents(metrics))
+            {
+                response << "Components: " << mst.componentCount << "\n";
+                for (std::size_t k = 0; k < mst.components.size(); ++k)
+                {
+                    const ComponentStats &component = mst.components[k];
+                    response << "Component " << k << ": " << component.vertexCount << " vertices, weight "
+                             << component.totalWeight << ", diameter " << component.diameter << "\n";
+                }
+            }
+            if (hasDistances(metrics))
+            {
+                response << "Shortest paths in MST:\n";
+
+                for (const auto &row : mst.shortestDistances)
                 {
-                    response << "From " + std::to_string(row.first) + " to " + std::to_string(dist.first) + ": " + std::to_string(dist.second) + "\n";
+                    for (const auto &dist : row.second)
+                    {
+                        response << "From " + std::to_string(row.first) + " to " + std::to_string(dist.first) + ": " + std::to_string(dist.second) + "\n";
+                    }
                 }
             }
 
@@ -8,8 +8,11 @@
 #include <atomic>
 #include <memory>
 #include "Graph.hpp"
+#include "GraphImporter.hpp"
 #include "MSTFactory.hpp"
 #include "MSTResult.hpp"
+#include "DynamicMST.hpp"
+#include "MSTResultCache.hpp"
 #include "LFP.hpp"
 
 // Task structure to represent each client request in the pipeline
@@ -20,6 +23,12 @@ struct Triple
     int clientFd;        // Client's file descriptor to send final results
 };
 
+// Memory budget of the MST results cached for repeated solves, shared by all clients
+constexpr std::size_t MST_CACHE_BUDGET_BYTES = std::size_t(256) << 20;
+
+// Upper bound on the edges of one AddEdges block; larger blocks are read and dropped
+constexpr int32_t MAX_BULK_EDGES = 1 << 26;
+
 class Server
 {
 public:
@@ -39,19 +48,34 @@ private:
     std::vector<std::thread> client_threads; // Vector to store client handler threads
 
     // Maps to store client-specific data
-    std::map<int, Graph> clients_graphs; // Graphs by client ID
+    std::map<int, std::shared_ptr<Graph>> clients_graphs; // Current graph version by client ID, shared with running solves
+    std::map<int, std::unique_ptr<DynamicMST>> maintainedMSTs; // MST of the current graph version by client ID, under clientsGraphsMutex
+    std::map<int, int> graphPins; // Solves and saves reading the current graph version by client ID, under clientsGraphsMutex
+    MSTResultCache resultCache{MST_CACHE_BUDGET_BYTES};         // Results of recent solves by client, graph version and algorithm
     std::map<int, MSTResult> mstResults; // Msts by client ID
     std::map<int, Triple *> clientTasks; // Tasks by client ID
 
     void handleClient(int client_socket);                               // Processes client connections
     void processRequest(int client_socket, const std::string &request); // Handles client requests
+    bool receiveBulkEdges(int client_socket, std::string &request); // Reads an AddEdges block
     void closeAllConnections();
 
     // MST-related functions
-    void addGraph(int client_id, int n);                   // Adds a new graph for a client
-    void addEdge(int client_id, int i, int j, int weight); // Adds an edge
+    Graph &editableGraph(int client_id);                   // Copy-on-write access to a client's graph
+    std::shared_ptr<const Graph> pinGraph(int client_id);  // Current graph version, kept unmodified until released
+    void releaseGraph(int client_id, const std::shared_ptr<const Graph> &graph); // Releases a pin of pinGraph
+    void updateMaintainedMST(int client_id, std::size_t added); // Offers the last added edges to the client's MST
+    void reinstallMaintainedMST(int client_id, const std::shared_ptr<const Graph> &graph,
+                                std::unique_ptr<DynamicMST> dynamic); // Puts back an MST updated outside the lock
+    void addGraph(int client_id, long long n);                // Adds a new graph for a client
+    void addEdge(int client_id, int i, int j, Weight weight); // Adds an edge
+    void addEdges(int client_id, const std::vector<int32_t> &triples); // Adds a block of edges
     void removeEdge(int client_id, int i, int j);          // Removes an edge
-    void solveMSTWithLF(int client_id, MSTAlgorithmType algoType);
+    void loadGraph(int client_id, const std::string &path); // Attaches a memory-mapped graph file
+    void saveGraph(int client_id, const std::string &path); // Writes the graph as a graph file
+    void importGraph(int client_id, const std::string &path, const std::string &format, bool collapseParallel); // Parses a text graph file
+    void solveMSTWithLF(int client_id, MSTAlgorithmType algoType, VertexOrdering ordering,
+                        MSTMetrics metrics); // Solves, optionally on a relabeled graph, computing the selected metrics
 
     // Send results to client
     void sendTotalWeight(int client_socket, int client_id);
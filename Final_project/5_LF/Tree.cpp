@@ -1,38 +1,74 @@
 #include "Tree.hpp"
+#include "Adjacency.hpp"
+#include "union_find.hpp"
 #include <limits>
 #include <queue>
-#include <unordered_set>
 #include <vector>
 #include <algorithm>
 
-// Constructor initializes the MST edges and calculates all-pairs shortest paths
-Tree::Tree(const std::vector<std::tuple<int, int, int, int>> &mst) : mstEdges(mst)
+// Constructor initializes the MST edges and, unless told otherwise, calculates all-pairs shortest paths
+Tree::Tree(const EdgeList &mst, bool allPairs) : mstEdges(mst), allPairs(allPairs)
 {
-    calculateAllPairsShortestPaths();
+    if (allPairs)
+        calculateAllPairsShortestPaths();
 }
 
-// Private function to compute shortest paths between all vertex pairs using Dijkstra's algorithm
-void Tree::calculateAllPairsShortestPaths()
+namespace
 {
-    // Build adjacency list from MST edges
-    std::unordered_map<int, std::vector<std::pair<int, int>>> adjList;
-    for (const auto &[v1, v2, weight, id] : mstEdges)
+    // Walks the tree of 'start' and returns its vertex farthest from 'start'. 'distances' must hold
+    // INF for the vertices of that tree, and is left holding their distances from 'start'.
+    int farthestVertex(const Adjacency &adj, int start, std::vector<Distance> &distances, std::vector<int> &stack)
     {
-        adjList[v1].emplace_back(v2, weight); // Connect v1 to v2 with weight
-        adjList[v2].emplace_back(v1, weight); // Connect v2 to v1 with weight (undirected graph)
+        int farthest = start;
+        distances[start] = 0;
+        stack.assign(1, start);
+        while (!stack.empty())
+        {
+            int u = stack.back();
+            stack.pop_back();
+            if (distances[u] > distances[farthest])
+                farthest = u;
+            for (int k = adj.offsets[u]; k < adj.offsets[u + 1]; ++k)
+            {
+                int v = adj.targets[k];
+                if (distances[v] == std::numeric_limits<Distance>::max())
+                {
+                    distances[v] = distances[u] + adj.weights[k];
+                    stack.push_back(v);
+                }
+            }
+        }
+        return farthest;
     }
+}
+
+// Private function to compute shortest paths between all vertex pairs using Dijkstra's algorithm
+void Tree::calculateAllPairsShortestPaths()
+{
+    // Build a CSR adjacency from the MST edges, in both directions (undirected graph)
+    int vertexCount = 0;
+    for (std::size_t i = 0; i < mstEdges.size(); ++i)
+        vertexCount = std::max(vertexCount, static_cast<int>(std::max(mstEdges.from[i], mstEdges.to[i])) + 1);
+    Adjacency adj = Adjacency::build(mstEdges.view(), vertexCount);
+
+    // Vertices that are touched by at least one MST edge
+    std::vector<int> vertices;
+    for (int v = 0; v < vertexCount; ++v)
+        if (adj.degree(v) > 0)
+            vertices.push_back(v);
+
+    constexpr Distance INF = std::numeric_limits<Distance>::max();
+    std::vector<Distance> distances(vertexCount);
 
     // Run Dijkstra's algorithm from each vertex to find shortest paths to all other vertices
-    for (const auto &[start, _] : adjList)
+    for (int start : vertices)
     {
         // Initialize distances for Dijkstra’s algorithm
-        std::unordered_map<int, int> distances;
-        for (const auto &[v, _] : adjList)
-            distances[v] = std::numeric_limits<int>::max();
+        std::fill(distances.begin(), distances.end(), INF);
         distances[start] = 0; // Distance to itself is 0
 
         // Priority queue to track the shortest path during traversal (min-heap)
-        using QueueElem = std::pair<int, int>; // Pair of (distance, vertex)
+        using QueueElem = std::pair<Distance, int>; // Pair of (distance, vertex)
         std::priority_queue<QueueElem, std::vector<QueueElem>, std::greater<QueueElem>> pq;
         pq.emplace(0, start);
 
@@ -47,9 +83,10 @@ void Tree::calculateAllPairsShortestPaths()
                 continue;
 
             // Update distances for each neighbor of u
-            for (const auto &[v, weight] : adjList[u])
+            for (int k = adj.offsets[u]; k < adj.offsets[u + 1]; ++k)
             {
-                int newDist = currentDist + weight;
+                int v = adj.targets[k];
+                Distance newDist = currentDist + adj.weights[k];
                 if (newDist < distances[v])
                 { // Found a shorter path to v
                     distances[v] = newDist;
@@ -58,38 +95,30 @@ void Tree::calculateAllPairsShortestPaths()
             }
         }
 
-        // Store distances from 'start' to all other vertices in the shortestPathMatrix
-        shortestPathMatrix[start] = distances;
+        // Store distances from 'start' to the other vertices of its tree in the shortestPathMatrix
+        auto &row = shortestPathMatrix[start];
+        for (int v : vertices)
+            if (distances[v] != INF)
+                row[v] = distances[v];
     }
 }
 
-// Function to calculate the total weight of the MST by summing the weights of unique edges
-int Tree::calculateTotalWeight() const
+// Function to calculate the total weight of the MST by summing the weights of its edges.
+// Every undirected edge appears once in the MST, so a plain scan of the weight array suffices.
+Distance Tree::calculateTotalWeight() const
 {
-    int totalWeight = 0;
-    std::unordered_set<int> countedEdges; // Track unique edge IDs to avoid double-counting
-
-    for (const auto &edge : mstEdges)
-    {
-        int edgeId = std::get<3>(edge); // Extract edge ID
-        if (countedEdges.find(edgeId) == countedEdges.end())
-        {                                     // Only add if edge hasn't been counted yet
-            totalWeight += std::get<2>(edge); // Add weight
-            countedEdges.insert(edgeId);      // Mark as counted
-        }
-    }
-    return totalWeight;
+    return mstEdges.totalWeight();
 }
 
 // Function to find the longest shortest path in the MST (max distance between any two vertices)
-int Tree::calculateLongestDistance() const
+Distance Tree::calculateLongestDistance() const
 {
-    int longestDistance = 0;
+    Distance longestDistance = 0;
     for (const auto &[_, distances] : shortestPathMatrix)
     {
         for (const auto &[_, dist] : distances)
         {
-            if (dist != std::numeric_limits<int>::max())
+            if (dist != std::numeric_limits<Distance>::max())
             { // Ignore unreachable distances
                 longestDistance = std::max(longestDistance, dist);
             }
@@ -101,13 +130,13 @@ int Tree::calculateLongestDistance() const
 // Function to calculate the average shortest path distance between all vertex pairs
 double Tree::calculateAverageDistance() const
 {
-    int totalDistance = 0;
-    int pairCount = 0;
+    Distance totalDistance = 0; // Wide accumulator, a sum over all pairs overflows an int
+    long long pairCount = 0;
     for (const auto &[_, distances] : shortestPathMatrix)
     {
         for (const auto &[_, dist] : distances)
         {
-            if (dist > 0 && dist != std::numeric_limits<int>::max())
+            if (dist > 0 && dist != std::numeric_limits<Distance>::max())
             { // Ignore self-distances and unreachable pairs
                 totalDistance += dist;
                 ++pairCount;
@@ -118,7 +147,7 @@ double Tree::calculateAverageDistance() const
 }
 
 // Function to get the shortest distance between two specific vertices (start and end)
-int Tree::calculateShortestDistance(int start, int end) const
+Distance Tree::calculateShortestDistance(int start, int end) const
 {
     auto it = shortestPathMatrix.find(start);
     if (it != shortestPathMatrix.end())
@@ -129,11 +158,65 @@ int Tree::calculateShortestDistance(int start, int end) const
             return distIt->second; // Return precomputed shortest path from start to end
         }
     }
-    return std::numeric_limits<int>::max(); // Return infinity if no path is found
+    return std::numeric_limits<Distance>::max(); // Return infinity if no path is found
+}
+
+// Function to split a minimum spanning forest into its trees, with the weight and diameter of each
+std::vector<ComponentStats> Tree::calculateComponents(int vertexCount) const
+{
+    for (std::size_t i = 0; i < mstEdges.size(); ++i)
+        vertexCount = std::max(vertexCount, static_cast<int>(std::max(mstEdges.from[i], mstEdges.to[i])) + 1);
+    SparseUnionFind uf(vertexCount);
+    for (std::size_t i = 0; i < mstEdges.size(); ++i)
+        uf.unite(mstEdges.from[i], mstEdges.to[i]);
+
+    // Number the trees in order of their lowest vertex
+    std::vector<int> index(vertexCount, -1); // Tree of each union-find root
+    std::vector<ComponentStats> components;
+    for (int v = 0; v < vertexCount; ++v)
+    {
+        int &tree = index[uf.find_parent(v)];
+        if (tree < 0)
+        {
+            tree = static_cast<int>(components.size());
+            components.push_back({0, 0, 0});
+        }
+        ++components[tree].vertexCount;
+    }
+
+    for (std::size_t i = 0; i < mstEdges.size(); ++i)
+        components[index[uf.find_parent(mstEdges.from[i])]].totalWeight += mstEdges.weight[i];
+
+    // The diameter of a tree is the longest of the distances from its vertices
+    for (const auto &[start, distances] : shortestPathMatrix)
+    {
+        ComponentStats &stats = components[index[uf.find_parent(start)]];
+        for (const auto &[_, dist] : distances)
+            if (dist != std::numeric_limits<Distance>::max())
+                stats.diameter = std::max(stats.diameter, dist);
+    }
+    if (allPairs)
+        return components;
+
+    // Without the matrix: the vertex farthest from any vertex of a tree (the weights being non-negative)
+    // is an end of a longest path, so the distance to the vertex farthest from it is the diameter
+    Adjacency adj = Adjacency::build(mstEdges.view(), vertexCount);
+    constexpr Distance INF = std::numeric_limits<Distance>::max();
+    std::vector<Distance> fromAny(vertexCount, INF), fromEnd(vertexCount, INF);
+    std::vector<int> stack;
+    for (int v = 0; v < vertexCount; ++v)
+    {
+        if (fromAny[v] != INF || adj.degree(v) == 0)
+            continue;
+        int end = farthestVertex(adj, v, fromAny, stack);
+        int other = farthestVertex(adj, end, fromEnd, stack);
+        components[index[uf.find_parent(v)]].diameter = fromEnd[other];
+    }
+    return components;
 }
 
 // Accessor function to get the edges in the MST
-const std::vector<std::tuple<int, int, int, int>> &Tree::getMSTEdges() const
+const EdgeList &Tree::getMSTEdges() const
 {
     return mstEdges;
 }
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Adjacency.hpp"
+
+// Vertex relabelings that place neighbouring vertices at nearby IDs, so the per-vertex arrays
+// of the solvers (CSR rows, Prim's keys, the union-find parents) are accessed with better locality
+enum class VertexOrdering
+{
+    None,                 // Keep the input IDs
+    Bfs,                  // Breadth-first order
+    ReverseCuthillMcKee,  // BFS visiting neighbours by increasing degree, each component reversed
+    Invalid               // Invalid type, used for unsupported orderings
+};
+
+// Converts "" (no ordering), "BFS" or "RCM" to the corresponding VertexOrdering
+inline VertexOrdering stringToVertexOrdering(const std::string &ordering)
+{
+    if (ordering.empty())
+        return VertexOrdering::None;
+    if (ordering == "BFS")
+        return VertexOrdering::Bfs;
+    if (ordering == "RCM")
+        return VertexOrdering::ReverseCuthillMcKee;
+    return VertexOrdering::Invalid;
+}
+
+// Returns the new order of the vertices: order[k] is the vertex that becomes vertex k.
+// Components are laid out one after the other, starting with the component of vertex 0,
+// so a solver that starts from vertex 0 still starts in the same component.
+std::vector<VertexId> computeVertexOrder(const AdjacencyView &adj, VertexOrdering ordering);
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include "EdgeList.hpp"
+
+// Read-only view of a compressed sparse row (CSR) adjacency.
+// The neighbours of vertex v are stored in targets[offsets[v] .. offsets[v + 1]),
+// with the matching edge weights and edge IDs at the same positions.
+// The arrays may belong to an Adjacency or to a memory-mapped graph file.
+struct AdjacencyView
+{
+    const int *offsets = nullptr;      // vertexCount + 1 entries, offsets[v] is the first slot of v
+    const VertexId *targets = nullptr; // Neighbour vertex of each slot
+    const Weight *weights = nullptr;   // Weight of the edge in each slot
+    const int *ids = nullptr;          // ID of the edge in each slot
+    int vertices = 0;
+
+    int vertexCount() const
+    {
+        return vertices;
+    }
+
+    int degree(int v) const
+    {
+        return offsets[v + 1] - offsets[v];
+    }
+};
+
+// Owning CSR adjacency of an undirected graph, see AdjacencyView for the layout.
+struct Adjacency
+{
+    std::vector<int> offsets;
+    std::vector<VertexId> targets;
+    std::vector<Weight> weights;
+    std::vector<int> ids;
+
+    int vertexCount() const
+    {
+        return offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1;
+    }
+
+    int degree(int v) const
+    {
+        return offsets[v + 1] - offsets[v];
+    }
+
+    AdjacencyView view() const
+    {
+        return AdjacencyView{offsets.data(), targets.data(), weights.data(), ids.data(), vertexCount()};
+    }
+
+    // Builds the CSR arrays of an undirected edge list using a counting pass;
+    // every edge is inserted once in each direction.
+    static Adjacency build(const EdgeView &edges, int vertexCount)
+    {
+        Adjacency adj;
+        adj.offsets.assign(vertexCount + 1, 0);
+
+        // Prefix sum of the vertex degrees
+        std::vector<int> degrees = edges.countByVertex(vertexCount);
+        for (int v = 0; v < vertexCount; ++v)
+            adj.offsets[v + 1] = adj.offsets[v] + degrees[v];
+
+        int slots = adj.offsets[vertexCount];
+        adj.targets.resize(slots);
+        adj.weights.resize(slots);
+        adj.ids.resize(slots);
+
+        // Scatter the edges into their slots
+        std::vector<int> next(adj.offsets.begin(), adj.offsets.end() - 1);
+        auto place = [&adj, &next](VertexId from, VertexId to, Weight weight, int id)
+        {
+            int slot = next[from]++;
+            adj.targets[slot] = to;
+            adj.weights[slot] = weight;
+            adj.ids[slot] = id;
+        };
+        for (std::size_t i = 0; i < edges.size(); ++i)
+        {
+            place(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+            place(edges.to[i], edges.from[i], edges.weight[i], edges.id[i]);
+        }
+        return adj;
+    }
+};
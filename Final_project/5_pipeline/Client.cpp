@@ -1,6 +1,10 @@
 #include "Client.hpp"
+#include "MSTAlgorithmType.hpp"
 #include <iostream>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <vector>
 #include <unistd.h>
 #include <arpa/inet.h>
 
@@ -52,6 +56,46 @@ void Client::sendRequest(const std::string &request)
     fsync(client_fd);  // Ensure the data is written to the socket
 }
 
+// Reads "from to weight" lines from a file and sends them as a single binary block:
+// the bytes "AddEdges", an int32 edge count, then the (from, to, weight) int32 triples
+bool Client::sendEdgeFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Cannot open edge file " << path << "\n";
+        return false;
+    }
+
+    std::vector<int32_t> triples;
+    int32_t from, to, weight;
+    while (file >> from >> to >> weight)
+    {
+        triples.push_back(from);
+        triples.push_back(to);
+        triples.push_back(weight);
+    }
+
+    int32_t count = triples.size() / 3;
+    std::string block = "AddEdges";
+    block.append(reinterpret_cast<const char *>(&count), sizeof(count));
+    block.append(reinterpret_cast<const char *>(triples.data()), triples.size() * sizeof(int32_t));
+
+    size_t totalSent = 0;
+    while (totalSent < block.size())
+    {
+        ssize_t sentBytes = send(client_fd, block.data() + totalSent, block.size() - totalSent, 0);
+        if (sentBytes <= 0)
+        {
+            std::cerr << "Failed to send edge block\n";
+            return false;
+        }
+        totalSent += sentBytes;
+    }
+    std::cout << "Sent " << count << " edges\n";
+    return true;
+}
+
 // Receives the server's response as a string
 std::string Client::receiveResponse()
 {
@@ -102,7 +146,7 @@ int main()
     while (true)
     {
         std::string command;
-        std::cout << "Enter command (NewGraph, AddEdge, RemoveEdge, SolveMST Prim, SolveMST Kruskal): ";
+        std::cout << "Enter command (NewGraph, AddEdge, AddEdges <file>, RemoveEdge, LoadGraph <file>, SaveGraph <file>, ImportGraph <file> <edgelist|dimacs|metis> [collapse], SolveMST Prim|HeapPrim|PrimDense|Kruskal|Boruvka|FilterKruskal|RadixKruskal|LazyKruskal|Auto [BFS|RCM] [All|Weight|Components|Distances]): ";
         std::getline(std::cin, command);  // Read the user command
 
         if (command == "quit")
@@ -111,10 +155,21 @@ int main()
             break;  // Exit the loop if the user types "quit"
         }
 
+        // AddEdges uploads an edge file as a binary block instead of a text command
+        if (command.substr(0, 9) == "AddEdges ")
+        {
+            client.sendEdgeFile(command.substr(9));
+            continue;
+        }
+
         client.sendRequest(command);  // Send the command to the server
 
-        // If the command involves solving MST, expect a response and display it
-        if (command == "SolveMST Prim" || command == "SolveMST Kruskal")
+        // If the command solves an MST with a known algorithm, expect a response and display it
+        // (an optional vertex ordering and metrics selection may follow the algorithm name)
+        std::istringstream words(command);
+        std::string verb, algorithm;
+        words >> verb >> algorithm;
+        if (verb == "SolveMST" && stringToAlgorithmType(algorithm) != MSTAlgorithmType::Invalid)
         {
             std::string response = client.receiveResponse();  // Receive the response from the server
             std::cout << "The description of the mst:\n"
@@ -10,6 +10,7 @@ public:
 
     bool connectToServer();
     void sendRequest(const std::string &request);
+    bool sendEdgeFile(const std::string &path); // Sends a "from to weight" text file as one AddEdges block
     std::string receiveResponse();  // Receives a string response
 
 private:
@@ -0,0 +1,76 @@
+#include "ComponentSolver.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+bool ComponentBatches::plan(const Graph &graph, unsigned threads)
+{
+    EdgeView edges = graph.getEdges();
+    int vertexCount = graph.getVertexCount();
+    batchCount = 1;
+    unsigned wanted = threads ? threads : threadCountFor(edges.size());
+    if (wanted <= 1)
+        return false;
+
+    // Number the components that have edges, in order of their first edge, and count their edges
+    uf.reset(vertexCount);
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        uf.unite(edges.from[i], edges.to[i]);
+    component.assign(vertexCount, -1); // Component of each vertex, -1 for isolated vertices
+    edgeCount.clear();
+    for (std::size_t i = 0; i < edges.size(); ++i)
+    {
+        int &label = component[uf.find_parent(edges.from[i])];
+        if (label < 0)
+        {
+            label = static_cast<int>(edgeCount.size());
+            edgeCount.push_back(0);
+        }
+        ++edgeCount[label];
+    }
+    if (edgeCount.size() < wanted || *std::max_element(edgeCount.begin(), edgeCount.end()) > edges.size() / 2)
+        return false;
+    batchCount = wanted;
+
+    // Deal the components into batches, heaviest first onto the batch with the fewest edges
+    std::vector<int> byEdges(edgeCount.size());
+    std::iota(byEdges.begin(), byEdges.end(), 0);
+    std::sort(byEdges.begin(), byEdges.end(), [this](int a, int b)
+              { return edgeCount[a] > edgeCount[b]; });
+    std::vector<std::size_t> load(batchCount, 0);
+    std::vector<int> batchOf(edgeCount.size());
+    for (int c : byEdges)
+    {
+        unsigned b = static_cast<unsigned>(std::min_element(load.begin(), load.end()) - load.begin());
+        batchOf[c] = b;
+        load[b] += edgeCount[c];
+    }
+
+    // Number the vertices of each batch from 0, and list the edges of each batch
+    localId.assign(vertexCount, 0);
+    globalId.assign(batchCount, {});
+    for (int v = 0; v < vertexCount; ++v)
+    {
+        int c = component[uf.find_parent(v)];
+        if (c < 0)
+            continue;
+        std::vector<VertexId> &vertices = globalId[batchOf[c]];
+        localId[v] = static_cast<VertexId>(vertices.size());
+        vertices.push_back(static_cast<VertexId>(v));
+    }
+    slots.assign(batchCount, {});
+    for (unsigned b = 0; b < batchCount; ++b)
+        slots[b].reserve(load[b]);
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        slots[batchOf[component[uf.find_parent(edges.from[i])]]].push_back(static_cast<int>(i));
+    return true;
+}
+
+EdgeList ComponentSolver::computeMSTEdges(const Graph &graph)
+{
+    if (!batches.plan(graph, threads))
+        return solver->computeMSTEdges(graph);
+    return batches.solve(graph, [this](const Graph &batch)
+                         { return makeBatchSolver()->computeMSTEdges(batch); });
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "union_find.hpp"
+
+// Disjoint-set forest that any number of threads can use at once without locks, after
+// Jayanti and Tarjan, "Concurrent Disjoint Set Union" (and Anderson and Woll before them):
+//  - find compacts the path by halving; each shortcut is a single CAS that only ever points a node
+//    closer to its root, so a lost race merely skips one shortcut
+//  - unite links one root under the other with a CAS that fails if the root has been linked
+//    meanwhile, in which case the roots are found again and the link retried
+//  - roots are linked by a fixed pseudo-random priority of their index (linkPriority) instead of
+//    by rank, which keeps the expected depth logarithmic without a second array that would have
+//    to change together with the parent
+// Every operation is linearizable, and find is iterative, so deep chains cannot overflow the stack.
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(int n = 0) : components(0)
+    {
+        reset(n);
+    }
+
+    // Starts over with n singletons, reallocating only when n exceeds every earlier size.
+    // Must not run concurrently with any other operation.
+    void reset(int n)
+    {
+        if (n > capacity)
+        {
+            parent.reset(new std::atomic<int>[n]);
+            capacity = n;
+        }
+        for (int v = 0; v < n; ++v)
+            parent[v].store(v, std::memory_order_relaxed);
+        components.store(n, std::memory_order_relaxed);
+    }
+
+    // Root of the set of x
+    int find(int x)
+    {
+        int p = parent[x].load(std::memory_order_acquire);
+        while (p != x)
+        {
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (grandparent != p)
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_acq_rel, std::memory_order_acquire);
+            x = grandparent;
+            p = parent[x].load(std::memory_order_acquire);
+        }
+        return x;
+    }
+
+    // Merges the sets of x and y. Returns false if they already were the same set; when several
+    // threads unite the same two sets, exactly one of them gets true.
+    bool unite(int x, int y)
+    {
+        while (true)
+        {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return false;
+            if (linkPriority(x) > linkPriority(y))
+                std::swap(x, y);
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                components.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    // True if x and y are in the same set at some point during the call
+    bool sameSet(int x, int y)
+    {
+        while (true)
+        {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return true;
+            if (parent[x].load(std::memory_order_acquire) == x) // x was still a root after y was found
+                return false;
+        }
+    }
+
+    // Number of sets, exact once no unite is running
+    int componentCount() const
+    {
+        return components.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::unique_ptr<std::atomic<int>[]> parent;
+    int capacity = 0; // Length of 'parent'
+    std::atomic<int> components;
+};
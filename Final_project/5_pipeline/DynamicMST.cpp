@@ -0,0 +1,148 @@
+#include "DynamicMST.hpp"
+#include <algorithm>
+
+DynamicMST::DynamicMST(int vertexCount, const EdgeList &mst)
+    : vertexCount(vertexCount), tree(vertexCount + std::max(vertexCount - 1, 0))
+{
+    forest.reserve(std::max(vertexCount - 1, 0));
+    for (std::size_t i = 0; i < mst.size(); ++i)
+    {
+        forest.push_back(mst.from[i], mst.to[i], mst.weight[i], mst.id[i]);
+        attach(i, mst.from[i], mst.to[i], mst.weight[i], mst.id[i]);
+    }
+}
+
+bool DynamicMST::addEdge(VertexId from, VertexId to, Weight weight, int id)
+{
+    if (from == to)
+        return false;
+
+    // Joins two trees: the forest gains the edge
+    if (!tree.connected(from, to))
+    {
+        forest.push_back(from, to, weight, id);
+        attach(forest.size() - 1, from, to, weight, id);
+        ++changes;
+        return true;
+    }
+
+    // Closes a cycle: the new edge replaces the heaviest edge on it, if it is lighter
+    int node = tree.pathMax(from, to);
+    std::size_t slot = node - vertexCount;
+    if (!(weight < forest.weight[slot]))
+    {
+        addNonTreeEdge(from, to, weight, id);
+        return false;
+    }
+    addNonTreeEdge(forest.from[slot], forest.to[slot], forest.weight[slot], forest.id[slot]);
+    detach(slot);
+    attach(slot, from, to, weight, id);
+    ++changes;
+    return true;
+}
+
+bool DynamicMST::removeEdges(const std::vector<int> &ids, const Graph &graph)
+{
+    bool changed = false;
+    for (int id : ids)
+    {
+        auto tracked = slotOf.find(id);
+        if (tracked != slotOf.end())
+        {
+            if (!indexed)
+                indexNonTreeEdges(graph);
+            removeTreeEdge(tracked->second);
+            changed = true;
+        }
+        else if (indexed)
+        {
+            auto it = nonTreeById.find(id);
+            if (it != nonTreeById.end())
+            {
+                nonTree.erase(it->second);
+                nonTreeById.erase(it);
+            }
+        }
+    }
+    changes += changed;
+    return changed;
+}
+
+bool DynamicMST::touchesForest(const std::vector<int> &ids) const
+{
+    for (int id : ids)
+        if (slotOf.count(id))
+            return true;
+    return false;
+}
+
+void DynamicMST::removeTreeEdge(std::size_t slot)
+{
+    VertexId u = forest.from[slot], v = forest.to[slot];
+    detach(slot);
+
+    // The first non-tree edge, by weight, with an endpoint on each side of the cut replaces it
+    for (auto it = nonTree.begin(); it != nonTree.end(); ++it)
+    {
+        bool crosses = tree.connected(it->from, u) ? tree.connected(it->to, v)
+                                                   : tree.connected(it->from, v) && tree.connected(it->to, u);
+        if (crosses)
+        {
+            NonTreeEdge replacement = *it;
+            nonTreeById.erase(replacement.id);
+            nonTree.erase(it);
+            attach(slot, replacement.from, replacement.to, replacement.weight, replacement.id);
+            return;
+        }
+    }
+
+    // No edge crosses the cut: the tree stays split. Move the last slot into the hole.
+    std::size_t last = forest.size() - 1;
+    if (slot != last)
+    {
+        VertexId from = forest.from[last], to = forest.to[last];
+        Weight weight = forest.weight[last];
+        int id = forest.id[last];
+        detach(last);
+        attach(slot, from, to, weight, id);
+    }
+    forest.eraseSwap(last);
+}
+
+void DynamicMST::attach(std::size_t slot, VertexId from, VertexId to, Weight weight, int id)
+{
+    forest.from[slot] = from;
+    forest.to[slot] = to;
+    forest.weight[slot] = weight;
+    forest.id[slot] = id;
+    slotOf[id] = slot;
+
+    int node = vertexCount + static_cast<int>(slot);
+    tree.setValue(node, weight);
+    tree.link(from, node);
+    tree.link(node, to);
+}
+
+void DynamicMST::detach(std::size_t slot)
+{
+    int node = vertexCount + static_cast<int>(slot);
+    tree.cut(forest.from[slot], node);
+    tree.cut(node, forest.to[slot]);
+    slotOf.erase(forest.id[slot]);
+}
+
+void DynamicMST::indexNonTreeEdges(const Graph &graph)
+{
+    indexed = true;
+    EdgeView edges = graph.getEdges();
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        if (slotOf.find(edges.id[i]) == slotOf.end())
+            addNonTreeEdge(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+}
+
+void DynamicMST::addNonTreeEdge(VertexId from, VertexId to, Weight weight, int id)
+{
+    if (!indexed || from == to)
+        return;
+    nonTreeById[id] = nonTree.insert(NonTreeEdge{weight, id, from, to}).first;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include "GraphTypes.hpp"
+
+// Read-only structure-of-arrays view of an edge list: edge i is (from[i], to[i], weight[i], id[i]).
+// The arrays may belong to an EdgeList or to a memory-mapped graph file.
+// Keeping every field in its own contiguous array lets the scans below run over plain
+// arrays of numbers, which the compiler auto-vectorizes at -O2.
+struct EdgeView
+{
+    const VertexId *from = nullptr;
+    const VertexId *to = nullptr;
+    const Weight *weight = nullptr;
+    const int *id = nullptr;
+    std::size_t count = 0;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Smallest weight in the list, or the largest Weight if it is empty
+    Weight minWeight() const
+    {
+        Weight best = std::numeric_limits<Weight>::max();
+        for (std::size_t i = 0; i < count; ++i)
+            best = weight[i] < best ? weight[i] : best;
+        return best;
+    }
+
+    // Sum of all the weights
+    Distance totalWeight() const
+    {
+        Distance sum = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            sum += weight[i];
+        return sum;
+    }
+
+    // Indices of the edges whose weight is at most maxWeight, in their original order.
+    // The store is unconditional and only the output cursor depends on the comparison,
+    // so the loop has no data-dependent branch.
+    std::vector<int> filterByWeight(Weight maxWeight) const
+    {
+        std::vector<int> selected(count + 1);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            selected[kept] = static_cast<int>(i);
+            kept += (weight[i] <= maxWeight);
+        }
+        selected.resize(kept);
+        return selected;
+    }
+
+    // Number of edge endpoints at every vertex (a self-loop counts twice)
+    std::vector<int> countByVertex(int vertexCount) const
+    {
+        std::vector<int> counts(vertexCount, 0);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            ++counts[from[i]];
+            ++counts[to[i]];
+        }
+        return counts;
+    }
+};
+
+// Owning structure-of-arrays edge container, see EdgeView for the layout and the scans.
+struct EdgeList
+{
+    std::vector<VertexId> from;
+    std::vector<VertexId> to;
+    std::vector<Weight> weight;
+    std::vector<int> id;
+
+    std::size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+
+    EdgeView view() const
+    {
+        return EdgeView{from.data(), to.data(), weight.data(), id.data(), id.size()};
+    }
+
+    void reserve(std::size_t n)
+    {
+        from.reserve(n);
+        to.reserve(n);
+        weight.reserve(n);
+        id.reserve(n);
+    }
+
+    // Grows or shrinks to n edges; new edges are left for the caller to fill in
+    void resize(std::size_t n)
+    {
+        from.resize(n);
+        to.resize(n);
+        weight.resize(n);
+        id.resize(n);
+    }
+
+    void clear()
+    {
+        from.clear();
+        to.clear();
+        weight.clear();
+        id.clear();
+    }
+
+    void push_back(VertexId u, VertexId v, Weight w, int edgeId)
+    {
+        from.push_back(u);
+        to.push_back(v);
+        weight.push_back(w);
+        id.push_back(edgeId);
+    }
+
+    // Removes edge i by moving the last edge into its place (order is not preserved)
+    void eraseSwap(std::size_t i)
+    {
+        std::size_t last = size() - 1;
+        from[i] = from[last];
+        to[i] = to[last];
+        weight[i] = weight[last];
+        id[i] = id[last];
+        from.pop_back();
+        to.pop_back();
+        weight.pop_back();
+        id.pop_back();
+    }
+
+    Weight minWeight() const { return view().minWeight(); }
+    Distance totalWeight() const { return view().totalWeight(); }
+    std::vector<int> filterByWeight(Weight maxWeight) const { return view().filterByWeight(maxWeight); }
+    std::vector<int> countByVertex(int vertexCount) const { return view().countByVertex(vertexCount); }
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "EdgeList.hpp"
+#include "Adjacency.hpp"
+#include "GraphTypes.hpp"
+
+// Binary graph file, version 2. All fields are in host byte order.
+//
+//   GraphFileHeader
+//   VertexId from[edgeCount], to[edgeCount]; Weight weight[edgeCount]; int32 id[edgeCount]    (edge list)
+//   int32 offsets[vertexCount + 1]                                                             (CSR)
+//   VertexId targets[2 * edgeCount]; Weight weights[2 * edgeCount]; int32 ids[2 * edgeCount]
+//
+// Every array starts on an 8-byte boundary (zero padding in between). The header records the
+// VertexId and Weight types the file was written with, and a build only loads files of its own types.
+// The file is mapped read-only and the arrays are used in place, so loading it needs no parsing.
+struct GraphFileHeader
+{
+    char magic[8];              // "MSTGRAPH"
+    std::uint32_t version;      // GRAPH_FILE_VERSION
+    std::uint8_t vertexBytes;   // sizeof(VertexId)
+    std::uint8_t vertexSigned;  // 1 if VertexId is signed
+    std::uint8_t weightBytes;   // sizeof(Weight)
+    std::uint8_t weightFloat;   // 1 if Weight is a floating point type
+    std::int64_t vertexCount;
+    std::int64_t edgeCount;
+    std::int64_t nextEdgeId;    // ID assigned to the next edge added to the loaded graph
+};
+
+constexpr std::uint32_t GRAPH_FILE_VERSION = 2;
+
+// A graph file mapped into memory with mmap. The mapping lives as long as the object.
+class MappedGraphFile
+{
+public:
+    // Maps and validates the file. Returns nullptr and sets 'error' on failure.
+    static std::shared_ptr<const MappedGraphFile> open(const std::string &path, std::string &error);
+
+    ~MappedGraphFile();
+    MappedGraphFile(const MappedGraphFile &) = delete;
+    MappedGraphFile &operator=(const MappedGraphFile &) = delete;
+
+    int vertexCount() const { return static_cast<int>(header->vertexCount); }
+    int nextEdgeId() const { return static_cast<int>(header->nextEdgeId); }
+    EdgeView edges() const { return edgeView; }
+    AdjacencyView adjacency() const { return adjacencyView; }
+
+private:
+    MappedGraphFile() = default;
+
+    void *data = nullptr;
+    std::size_t length = 0;
+    const GraphFileHeader *header = nullptr;
+    EdgeView edgeView;
+    AdjacencyView adjacencyView;
+};
+
+// Writes a graph in the binary format above. Returns false and sets 'error' on failure.
+bool writeGraphFile(const std::string &path, int vertexCount, int nextEdgeId,
+                    const EdgeView &edges, const AdjacencyView &adjacency, std::string &error);
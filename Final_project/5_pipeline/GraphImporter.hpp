@@ -0,0 +1,36 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "Graph.hpp"
+
+// Text graph formats understood by importGraph
+enum class GraphFormat
+{
+    EdgeList, // "u v [w]" per line, 0-based vertices, '#' or '%' comments, weight 1 if omitted
+    Dimacs,   // DIMACS shortest path .gr: "p sp n m" header, "a u v w" arcs, 1-based vertices
+    Metis,    // METIS: "n m [fmt [ncon]]" header, then the 1-based neighbour list of each vertex
+    Invalid   // Invalid type, used for unsupported formats
+};
+
+// Converts "edgelist", "dimacs" or "metis" to the corresponding GraphFormat
+inline GraphFormat stringToGraphFormat(const std::string &format)
+{
+    if (format == "edgelist")
+        return GraphFormat::EdgeList;
+    if (format == "dimacs")
+        return GraphFormat::Dimacs;
+    if (format == "metis")
+        return GraphFormat::Metis;
+    return GraphFormat::Invalid;
+}
+
+// Maps the file, splits it into line-aligned chunks and parses them on 'threads' threads
+// (0 = one per hardware thread) with std::from_chars, then builds the Graph from the chunks.
+// METIS lists every edge in the neighbour lists of both its endpoints, and gets a single
+// undirected edge per listed pair. Every DIMACS arc becomes an edge, so a road listed in both
+// directions gives two parallel edges, as would repeated lines of any format. With
+// 'collapseParallel', only the lightest edge of each vertex pair is kept, on 'threads' threads
+// as well; the others can never be in an MST.
+// Returns nullptr and sets 'error' on failure.
+std::shared_ptr<Graph> importGraph(const std::string &path, GraphFormat format, std::string &error, unsigned threads = 0,
+                                   bool collapseParallel = false);
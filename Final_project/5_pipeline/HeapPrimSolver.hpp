@@ -0,0 +1,20 @@
+#pragma once
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "IndexedHeap.hpp"
+
+// Prim's algorithm on an indexed 4-ary heap with a true decrease-key (see IndexedHeap).
+// Grows a tree from every vertex not reached yet, so a disconnected graph gets a spanning forest.
+class HeapPrimSolver : public MSTSolver
+{
+public:
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    // For every vertex waiting in the heap, the CSR slot of the lightest edge reaching it and its tree endpoint
+    std::vector<int> bestSlot;
+    std::vector<VertexId> bestFrom;
+    std::vector<char> inTree;
+    IndexedHeap<Weight, 4> heap;
+};
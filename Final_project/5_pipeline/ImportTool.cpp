@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+#include "GraphImporter.hpp"
+
+// Converts a text graph (edgelist, dimacs or metis) into a binary graph file for LoadGraph
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input> <edgelist|dimacs|metis> <output> [threads] [collapse]" << std::endl
+                  << "       collapse keeps only the lightest of parallel edges, e.g. the two arcs of a DIMACS road" << std::endl;
+        return 1;
+    }
+
+    unsigned threads = argc > 4 ? static_cast<unsigned>(std::stoul(argv[4])) : 0;
+    bool collapse = argc > 5 && std::string(argv[5]) == "collapse";
+    std::string error;
+    auto graph = importGraph(argv[1], stringToGraphFormat(argv[2]), error, threads, collapse);
+    if (!graph)
+    {
+        std::cerr << "Import failed: " << error << std::endl;
+        return 1;
+    }
+    if (!graph->save(argv[3], error))
+    {
+        std::cerr << "Save failed: " << error << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << argv[3] << " with " << graph->getVertexCount() << " vertices and "
+              << graph->getEdges().size() << " edges" << std::endl;
+    return 0;
+}
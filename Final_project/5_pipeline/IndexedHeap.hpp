@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+
+// Min-priority queue over the items 0..n-1, stored as a flat D-ary heap array.
+// A position index gives O(1) lookup of every item, so decreaseKey moves the item in place
+// instead of erasing and re-inserting it; nothing is allocated after construction, nor by a
+// reset to a size no larger than any earlier one.
+template <typename Key, int D = 4>
+class IndexedHeap
+{
+public:
+    explicit IndexedHeap(int n = 0)
+    {
+        reset(n);
+    }
+
+    // Empties the heap and makes it hold the items 0..n-1
+    void reset(int n)
+    {
+        keys.resize(n);
+        position.assign(n, -1);
+        heap.clear();
+        heap.reserve(n);
+    }
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int item) const { return position[item] >= 0; }
+    Key key(int item) const { return keys[item]; }
+
+    // Inserts an item that is not in the heap
+    void push(int item, Key key)
+    {
+        keys[item] = key;
+        position[item] = static_cast<int>(heap.size());
+        heap.push_back(item);
+        siftUp(position[item]);
+    }
+
+    // Lowers the key of an item that is in the heap
+    void decreaseKey(int item, Key key)
+    {
+        keys[item] = key;
+        siftUp(position[item]);
+    }
+
+    // Removes and returns the item with the smallest key
+    int pop()
+    {
+        int top = heap[0];
+        int last = heap.back();
+        heap.pop_back();
+        position[top] = -1;
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            position[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    std::vector<Key> keys;     // Key of every item
+    std::vector<int> position; // Index of every item in 'heap', -1 if it is not in the heap
+    std::vector<int> heap;     // Items in heap order, the children of i are D*i+1 .. D*i+D
+
+    void place(int item, int at)
+    {
+        heap[at] = item;
+        position[item] = at;
+    }
+
+    void siftUp(int at)
+    {
+        int item = heap[at];
+        while (at > 0)
+        {
+            int parent = (at - 1) / D;
+            if (!(keys[item] < keys[heap[parent]]))
+                break;
+            place(heap[parent], at);
+            at = parent;
+        }
+        place(item, at);
+    }
+
+    void siftDown(int at)
+    {
+        int item = heap[at];
+        int size = static_cast<int>(heap.size());
+        while (true)
+        {
+            int first = D * at + 1;
+            if (first >= size)
+                break;
+            int last = first + D < size ? first + D : size;
+            int best = first;
+            for (int child = first + 1; child < last; ++child)
+                if (keys[heap[child]] < keys[heap[best]])
+                    best = child;
+            if (!(keys[heap[best]] < keys[item]))
+                break;
+            place(heap[best], at);
+            at = best;
+        }
+        place(item, at);
+    }
+};
@@ -1,9 +1,15 @@
 #pragma once
+#include <vector>
 #include "MSTSolver.hpp"
 #include "MSTResult.hpp"
+#include "union_find.hpp"
 
 class KruskalSolver : public MSTSolver
 {
 public:
-    MSTResult computeMST(const std::vector<std::tuple<int, int, int, int>> &edges, int vertexCount) override;
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    SparseUnionFind uf{0};
+    std::vector<int> order; // Edge indices sorted by weight
 };
@@ -0,0 +1,149 @@
+#include "LinkCutTree.hpp"
+#include <limits>
+#include <utility>
+
+LinkCutTree::LinkCutTree(int n)
+    : left(n, -1), right(n, -1), parent(n, -1), reversed(n, 0),
+      values(n, std::numeric_limits<Weight>::lowest()), heaviest(n)
+{
+    for (int v = 0; v < n; ++v)
+        heaviest[v] = v;
+}
+
+void LinkCutTree::setValue(int node, Weight value)
+{
+    access(node); // node is now the root of its splay tree, so only its own aggregate changes
+    values[node] = value;
+    update(node);
+}
+
+void LinkCutTree::link(int u, int v)
+{
+    makeRoot(u);
+    parent[u] = v; // A path-parent pointer: u hangs below v without joining v's preferred path
+}
+
+void LinkCutTree::cut(int u, int v)
+{
+    makeRoot(u);
+    access(v);
+    // The path is now u - v with v at the splay root, so u is its whole left subtree
+    parent[left[v]] = -1;
+    left[v] = -1;
+    update(v);
+}
+
+bool LinkCutTree::connected(int u, int v)
+{
+    return u == v || findRoot(u) == findRoot(v);
+}
+
+int LinkCutTree::pathMax(int u, int v)
+{
+    makeRoot(u);
+    access(v);
+    return heaviest[v];
+}
+
+bool LinkCutTree::isSplayRoot(int x) const
+{
+    int p = parent[x];
+    return p < 0 || (left[p] != x && right[p] != x);
+}
+
+void LinkCutTree::update(int x)
+{
+    int best = x;
+    if (left[x] >= 0 && values[heaviest[left[x]]] > values[best])
+        best = heaviest[left[x]];
+    if (right[x] >= 0 && values[heaviest[right[x]]] > values[best])
+        best = heaviest[right[x]];
+    heaviest[x] = best;
+}
+
+void LinkCutTree::push(int x)
+{
+    if (!reversed[x])
+        return;
+    std::swap(left[x], right[x]);
+    if (left[x] >= 0)
+        reversed[left[x]] ^= 1;
+    if (right[x] >= 0)
+        reversed[right[x]] ^= 1;
+    reversed[x] = 0;
+}
+
+void LinkCutTree::rotate(int x)
+{
+    int p = parent[x], g = parent[p];
+    if (!isSplayRoot(p))
+        (left[g] == p ? left[g] : right[g]) = x;
+    parent[x] = g;
+    if (left[p] == x)
+    {
+        left[p] = right[x];
+        if (right[x] >= 0)
+            parent[right[x]] = p;
+        right[x] = p;
+    }
+    else
+    {
+        right[p] = left[x];
+        if (left[x] >= 0)
+            parent[left[x]] = p;
+        left[x] = p;
+    }
+    parent[p] = x;
+    update(p);
+    update(x);
+}
+
+void LinkCutTree::splay(int x)
+{
+    // Push the pending reversals down the path from the splay root first, so the rotations see real children
+    std::vector<int> &path = splayPath;
+    path.clear();
+    for (int y = x;; y = parent[y])
+    {
+        path.push_back(y);
+        if (isSplayRoot(y))
+            break;
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+        push(*it);
+
+    while (!isSplayRoot(x))
+    {
+        int p = parent[x];
+        if (!isSplayRoot(p))
+            rotate((left[p] == x) == (left[parent[p]] == p) ? p : x); // Zig-zig rotates the parent first
+        rotate(x);
+    }
+}
+
+// Makes the root-to-x path preferred, with x at the root of its splay tree and no deeper nodes on it
+void LinkCutTree::access(int x)
+{
+    for (int last = -1, y = x; y >= 0; last = y, y = parent[y])
+    {
+        splay(y);
+        right[y] = last;
+        update(y);
+    }
+    splay(x);
+}
+
+void LinkCutTree::makeRoot(int x)
+{
+    access(x);
+    reversed[x] ^= 1;
+}
+
+int LinkCutTree::findRoot(int x)
+{
+    access(x);
+    for (push(x); left[x] >= 0; push(x))
+        x = left[x];
+    splay(x); // Keeps the next search for this root short
+    return x;
+}
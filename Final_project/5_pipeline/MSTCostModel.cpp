@@ -0,0 +1,192 @@
+#include "MSTCostModel.hpp"
+#include "PrimDenseSolver.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+
+namespace
+{
+    constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+    double log2Of(double x)
+    {
+        return std::log2(std::max(x, 2.0));
+    }
+
+    // Byte passes the radix sort can't skip: one per byte of the weight range, every byte for floats
+    double radixPasses(double weightRange)
+    {
+        if (std::is_floating_point_v<Weight>)
+            return sizeof(Weight);
+        return std::max(1.0, std::ceil(std::log2(weightRange + 1) / 8));
+    }
+}
+
+GraphShape GraphShape::of(const Graph &graph)
+{
+    GraphShape shape;
+    EdgeView edges = graph.getEdges();
+    shape.vertices = graph.getVertexCount();
+    shape.edges = static_cast<double>(edges.size());
+    if (shape.vertices > 1)
+        shape.density = shape.edges / (shape.vertices * (shape.vertices - 1) / 2);
+    if (edges.size() > 0)
+    {
+        auto [lightest, heaviest] = std::minmax_element(edges.weight, edges.weight + edges.size());
+        shape.weightRange = static_cast<double>(*heaviest) - static_cast<double>(*lightest);
+    }
+    return shape;
+}
+
+MSTCostModel::MSTCostModel()
+{
+    set(MSTAlgorithmType::Prim, {53.8, 1.13e-5});
+    set(MSTAlgorithmType::HeapPrim, {0.0, 3.32e-5});
+    set(MSTAlgorithmType::PrimDense, {0.0, 1.43e-5});
+    set(MSTAlgorithmType::Kruskal, {62.5, 6.34e-6});
+    set(MSTAlgorithmType::Boruvka, {6.6, 7.30e-6});
+    set(MSTAlgorithmType::FilterKruskal, {21.5, 1.59e-5});
+    set(MSTAlgorithmType::RadixKruskal, {0.0, 3.02e-5});
+    set(MSTAlgorithmType::LazyKruskal, {0.0, 2.0e-5});
+}
+
+MSTCostModel::Coefficients MSTCostModel::get(MSTAlgorithmType algorithmType) const
+{
+    return coefficients[static_cast<std::size_t>(algorithmType)];
+}
+
+void MSTCostModel::set(MSTAlgorithmType algorithmType, Coefficients values)
+{
+    coefficients[static_cast<std::size_t>(algorithmType)] = values;
+}
+
+bool MSTCostModel::load(const std::string &path, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    // Parse every line before applying any, so a bad file leaves the model unchanged
+    MSTCostModel loaded = *this;
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number)
+    {
+        std::istringstream iss(line);
+        std::string name;
+        if (!(iss >> name) || name[0] == '#')
+            continue;
+
+        Coefficients values;
+        MSTAlgorithmType algorithmType = stringToAlgorithmType(name);
+        if (static_cast<std::size_t>(algorithmType) >= ALGORITHM_COUNT || !(iss >> values.overhead >> values.perUnit) ||
+            values.overhead < 0 || values.perUnit < 0)
+        {
+            error = path + ":" + std::to_string(number) + ": expected \"<algorithm> <overhead ms> <ms per unit>\"";
+            return false;
+        }
+        loaded.set(algorithmType, values);
+    }
+    *this = loaded;
+    return true;
+}
+
+bool MSTCostModel::save(const std::string &path, std::string &error) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    file << "# MST cost model, written by mst_benchmark --calibrate\n"
+         << "# <algorithm> <overhead ms> <ms per unit of work>\n";
+    file.precision(6);
+    for (std::size_t i = 0; i < ALGORITHM_COUNT; ++i)
+        file << algorithmTypeToString(static_cast<MSTAlgorithmType>(i)) << ' '
+             << coefficients[i].overhead << ' ' << coefficients[i].perUnit << '\n';
+    if (!file)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+double MSTCostModel::work(MSTAlgorithmType algorithmType, const GraphShape &shape)
+{
+    double v = shape.vertices, e = shape.edges;
+    switch (algorithmType)
+    {
+    case MSTAlgorithmType::Prim:
+        return (e + v) * log2Of(v); // Every edge may update the set-based queue
+    case MSTAlgorithmType::HeapPrim:
+        return e + v * log2Of(v); // decreaseKey is nearly free on a 4-ary heap, pops are not
+    case MSTAlgorithmType::PrimDense:
+        if (v > PrimDenseSolver::MAX_VERTICES)
+            return INFINITE_COST;
+        return v * v + e; // Scans plus building the matrix, which the density makes worth it or not
+    case MSTAlgorithmType::Kruskal:
+        return e * log2Of(e);
+    case MSTAlgorithmType::Boruvka:
+        return e * log2Of(v) / threadCountFor(static_cast<std::size_t>(e));
+    case MSTAlgorithmType::FilterKruskal:
+        return e + v * log2Of(v) * log2Of(e / std::max(v, 1.0)); // Only about V log(E/V) edges get sorted
+    case MSTAlgorithmType::RadixKruskal:
+        return e * (radixPasses(shape.weightRange) + 1); // The sort passes, then the union-find pass
+    case MSTAlgorithmType::LazyKruskal:
+    {
+        // The heapify, then the pops until the forest spans the graph. With random weights the last vertex
+        // to join is reached once the prefix covers a fraction 1 - V^(-V/2E) of the edges.
+        double popped = e > 0 ? e * (1 - std::exp(-v * std::log(std::max(v, 1.0)) / (2 * e))) : 0;
+        return e + popped * log2Of(e);
+    }
+    default:
+        return INFINITE_COST;
+    }
+}
+
+double MSTCostModel::predict(MSTAlgorithmType algorithmType, const GraphShape &shape) const
+{
+    double units = work(algorithmType, shape);
+    if (units == INFINITE_COST)
+        return INFINITE_COST;
+    Coefficients values = get(algorithmType);
+    return values.overhead + values.perUnit * units;
+}
+
+MSTAlgorithmType MSTCostModel::choose(const GraphShape &shape) const
+{
+    MSTAlgorithmType best = MSTAlgorithmType::Kruskal;
+    double bestCost = predict(best, shape);
+    for (std::size_t i = 0; i < ALGORITHM_COUNT; ++i)
+    {
+        MSTAlgorithmType algorithmType = static_cast<MSTAlgorithmType>(i);
+        double cost = predict(algorithmType, shape);
+        if (cost < bestCost)
+        {
+            best = algorithmType;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+const MSTCostModel &MSTCostModel::host()
+{
+    static const MSTCostModel model = []
+    {
+        MSTCostModel loaded;
+        std::string error;
+        loaded.load(DEFAULT_PATH, error); // Keeps the built-in coefficients if there is no valid file
+        return loaded;
+    }();
+    return model;
+}
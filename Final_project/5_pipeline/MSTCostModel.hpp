@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <string>
+#include "Graph.hpp"
+#include "MSTAlgorithmType.hpp"
+
+// The features of a graph the cost model looks at
+struct GraphShape
+{
+    double vertices = 0;
+    double edges = 0;
+    double density = 0;     // edges / (V (V - 1) / 2), the fraction of vertex pairs joined by an edge
+    double weightRange = 0; // Largest minus smallest edge weight
+
+    // Measures a graph: O(E) for the weight range, the rest is O(1)
+    static GraphShape of(const Graph &graph);
+};
+
+// Predicts the running time of each solver from the shape of a graph, so that SolveMST Auto can
+// pick the fastest one. Each solver gets a work estimate derived from its complexity (E log E for
+// Kruskal, V^2 for PrimDense, E per radix pass for RadixKruskal, ...) and its time is modelled as
+//     overhead + perUnit * work
+// The two coefficients of every solver are fitted on the host by 'mst_benchmark --calibrate' and
+// stored in a config file, one "<algorithm> <overhead ms> <ms per unit of work>" line per solver.
+class MSTCostModel
+{
+public:
+    struct Coefficients
+    {
+        double overhead = 0; // Fixed cost of a solve, in milliseconds
+        double perUnit = 0;  // Milliseconds per unit of work
+    };
+
+    // Config file looked up by host(), relative to the working directory of the server
+    static constexpr const char *DEFAULT_PATH = "mst_cost_model.conf";
+
+    // Number of solvers the model covers: every MSTAlgorithmType before Auto
+    static constexpr std::size_t ALGORITHM_COUNT = static_cast<std::size_t>(MSTAlgorithmType::Auto);
+
+    // Starts from built-in coefficients, fitted on a single-core x86-64 machine
+    MSTCostModel();
+
+    // Reads the coefficients listed in a config file; solvers the file omits keep their current ones.
+    // Returns false and sets 'error' if the file can't be read or has a malformed line.
+    bool load(const std::string &path, std::string &error);
+
+    // Writes every coefficient in the config file format. Returns false and sets 'error' on failure.
+    bool save(const std::string &path, std::string &error) const;
+
+    Coefficients get(MSTAlgorithmType algorithmType) const;
+    void set(MSTAlgorithmType algorithmType, Coefficients values);
+
+    // Work estimate of a solver on a graph of this shape, infinity if the solver can't take it
+    static double work(MSTAlgorithmType algorithmType, const GraphShape &shape);
+
+    // Predicted running time in milliseconds, infinity if the solver can't take the graph
+    double predict(MSTAlgorithmType algorithmType, const GraphShape &shape) const;
+
+    // The solver with the smallest predicted time
+    MSTAlgorithmType choose(const GraphShape &shape) const;
+
+    // Model of this host: DEFAULT_PATH if it exists and is valid, the built-in coefficients otherwise.
+    // Loaded once, on first use.
+    static const MSTCostModel &host();
+
+private:
+    std::array<Coefficients, ALGORITHM_COUNT> coefficients;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <utility>
+#include "EdgeList.hpp"
+#include "MSTResult.hpp"
+#include "Tree.hpp"
+
+// Enum class representing which metrics of an MST are computed besides its edges and total weight
+enum class MSTMetrics
+{
+    All,        // Everything below
+    Weight,     // The total weight only
+    Components, // The trees of the forest, with their weights and diameters
+    Distances,  // The longest and average distance, and the distances between all pairs of vertices
+    Invalid     // Invalid type, used for unsupported selections
+};
+
+// Converts "" (all metrics), "All", "Weight", "Components" or "Distances" to the corresponding MSTMetrics
+inline MSTMetrics stringToMSTMetrics(const std::string &metrics)
+{
+    if (metrics.empty() || metrics == "All")
+        return MSTMetrics::All;
+    if (metrics == "Weight")
+        return MSTMetrics::Weight;
+    if (metrics == "Components")
+        return MSTMetrics::Components;
+    if (metrics == "Distances")
+        return MSTMetrics::Distances;
+    return MSTMetrics::Invalid;
+}
+
+// Whether a selection includes the distance metrics, and the component metrics
+inline bool hasDistances(MSTMetrics metrics)
+{
+    return metrics == MSTMetrics::All || metrics == MSTMetrics::Distances;
+}
+
+inline bool hasComponents(MSTMetrics metrics)
+{
+    return metrics == MSTMetrics::All || metrics == MSTMetrics::Components;
+}
+
+// Compile-time selection of the metrics, for MSTContext. The metrics that are not selected are
+// not computed, nor compiled into measure(), and are left empty in the MSTResult.
+template <bool Distances, bool Components>
+struct MetricsPolicy
+{
+    static constexpr bool distances = Distances;
+    static constexpr bool components = Components;
+
+    // Builds the MSTResult of MST edges that are already known, for a graph of 'vertexCount' vertices
+    static MSTResult measure(EdgeList mst, int vertexCount)
+    {
+        MSTResult result{};
+        result.totalWeight = mst.totalWeight();
+        if constexpr (Distances || Components)
+        {
+            // The all-pairs distances are only worth their O(V^2) when they are asked for
+            Tree mstTree(mst, Distances);
+            if constexpr (Distances)
+            {
+                result.longestDistance = mstTree.calculateLongestDistance();
+                result.averageDistance = mstTree.calculateAverageDistance();
+                result.shortestDistances = mstTree.getShortestPathMatrix();
+            }
+            if constexpr (Components)
+            {
+                result.components = mstTree.calculateComponents(vertexCount);
+                result.componentCount = static_cast<int>(result.components.size());
+            }
+        }
+        result.mstEdges = std::move(mst);
+        return result;
+    }
+};
+
+using AllMetrics = MetricsPolicy<true, true>;
+using WeightMetrics = MetricsPolicy<false, false>;
+using ComponentMetrics = MetricsPolicy<false, true>;
+using DistanceMetrics = MetricsPolicy<true, false>;
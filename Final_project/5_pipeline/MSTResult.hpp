@@ -1,15 +1,27 @@
 #pragma once
 #include <vector>
 #include <unordered_map>
-#include <tuple>
+#include "EdgeList.hpp"
+
+// One tree of a minimum spanning forest
+struct ComponentStats
+{
+    int vertexCount;      // 1 for an isolated vertex
+    Distance totalWeight;
+    Distance diameter;    // Longest distance between two of its vertices
+};
 
 struct MSTResult
 {
-    std::vector<std::tuple<int, int, int, int>> mstEdges;
-    int totalWeight;
-    int longestDistance;
+    EdgeList mstEdges;
+    Distance totalWeight;
+    Distance longestDistance;
     double averageDistance;
 
     // Map of shortest distances between each pair of vertices
-    std::unordered_map<int, std::unordered_map<int, int>> shortestDistances;
+    std::unordered_map<int, std::unordered_map<int, Distance>> shortestDistances;
+
+    // Trees of the forest, isolated vertices included, in order of their lowest vertex
+    int componentCount;
+    std::vector<ComponentStats> components;
 };
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "MSTResult.hpp"
+#include "MSTAlgorithmType.hpp"
+#include "MSTMetrics.hpp"
+
+// MST results of recent solves, shared by all the clients of a server. An entry is keyed by the
+// client, the version of its graph (Graph::getVersion), the algorithm and the metrics selection, so a repeated SolveMST
+// on an unchanged graph skips the solver and the metrics altogether. The entries are kept within
+// a memory budget by evicting the least recently used ones, across clients. Graph versions only
+// grow, so caching a new version of a client's graph drops the entries of its older versions.
+// Safe to use from several threads.
+class MSTResultCache
+{
+public:
+    explicit MSTResultCache(std::size_t budgetBytes) : budget(budgetBytes) {}
+
+    // The cached result, nullptr if there is none. A hit makes the entry the most recently used.
+    std::shared_ptr<const MSTResult> find(int client, std::uint64_t graphVersion, MSTAlgorithmType algorithm,
+                                          MSTMetrics metrics);
+
+    // Caches a result, then evicts least recently used entries until the budget is met.
+    // A result larger than the whole budget is not cached.
+    void insert(int client, std::uint64_t graphVersion, MSTAlgorithmType algorithm, MSTMetrics metrics,
+                std::shared_ptr<const MSTResult> result);
+
+    // Drops every entry of a client
+    void eraseClient(int client);
+
+    // Memory held by the cached results, as estimated by footprint()
+    std::size_t usedBytes() const;
+
+    // Approximate memory held by a result, dominated by its all-pairs distance maps
+    static std::size_t footprint(const MSTResult &result);
+
+private:
+    struct Key
+    {
+        int client;
+        std::uint64_t graphVersion;
+        MSTAlgorithmType algorithm;
+        MSTMetrics metrics;
+
+        bool operator==(const Key &other) const
+        {
+            return client == other.client && graphVersion == other.graphVersion && algorithm == other.algorithm &&
+                   metrics == other.metrics;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const
+        {
+            return std::hash<std::uint64_t>()((key.graphVersion * 31 + static_cast<std::uint64_t>(key.algorithm)) * 7 +
+                                              static_cast<std::uint64_t>(key.metrics)) ^
+                   std::hash<int>()(key.client);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<const MSTResult> result;
+        std::size_t bytes;
+    };
+
+    std::size_t budget;
+    std::size_t used = 0;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    std::unordered_map<int, std::vector<std::list<Entry>::iterator>> byClient; // Entries of every client, so
+                                                                               // insert doesn't walk the others
+    mutable std::mutex mutex;
+
+    void erase(std::list<Entry>::iterator it);
+
+    // Erases the entries of a client for which drop(key) is true
+    template <typename Predicate>
+    void eraseIf(int client, Predicate drop);
+};
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "MSTFactory.hpp"
+#include "Server.hpp"
+
+// Regression tests of the solvers and the server, run by 'make test'. Every check prints a line,
+// and the exit status is the number of failed checks.
+static int failures = 0;
+
+static void check(bool condition, const std::string &name)
+{
+    std::cout << (condition ? "PASS " : "FAIL ") << name << std::endl;
+    if (!condition)
+        ++failures;
+}
+
+// 'components' random connected components of 'vertices' vertices each, numbered in turn
+static Graph fragmentedGraph(int components, int vertices, int extraEdges)
+{
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    Graph graph(components * vertices);
+    for (int c = 0; c < components; ++c)
+    {
+        int first = c * vertices;
+        std::uniform_int_distribution<int> vertex(first, first + vertices - 1);
+        for (int v = 1; v < vertices; ++v)
+            graph.addEdge(first + std::uniform_int_distribution<int>(0, v - 1)(random), first + v, weight(random));
+        for (int e = 0; e < extraEdges; ++e)
+            graph.addEdge(vertex(random), vertex(random), weight(random));
+    }
+    return graph;
+}
+
+// The compile-time path of MSTFactory::solve still solves the components of a fragmented graph in
+// parallel batches, and finds the same forest as a whole-graph solve
+static void testStaticContextSplitsComponents()
+{
+    Graph graph = fragmentedGraph(8, 50, 100);
+    MSTResult whole = AllMetrics::measure(KruskalSolver().computeMSTEdges(graph), graph.getVertexCount());
+
+    MSTFactory::StaticContext<KruskalSolver> context(std::in_place, 4u);
+    MSTResult split = context.computeMST(graph);
+    check(context.getSolver().lastBatchCount() == 4, "static context solves a fragmented graph in 4 batches");
+    check(split.totalWeight == whole.totalWeight, "batched forest has the weight of the whole-graph forest");
+    check(split.mstEdges.size() == whole.mstEdges.size(), "batched forest has as many edges as the whole-graph forest");
+    check(split.componentCount == 8, "batched forest has the 8 components");
+
+    bool sameComponents = split.components.size() == whole.components.size();
+    for (std::size_t i = 0; sameComponents && i < split.components.size(); ++i)
+        sameComponents = split.components[i].vertexCount == whole.components[i].vertexCount &&
+                         split.components[i].totalWeight == whole.components[i].totalWeight &&
+                         split.components[i].diameter == whole.components[i].diameter;
+    check(sameComponents, "batched forest has the component statistics of the whole-graph forest");
+
+    MSTResult counted = context.computeMST<ComponentMetrics>(graph);
+    check(counted.componentCount == 8 && counted.shortestDistances.empty(),
+          "the same context measures another metrics policy per solve");
+
+    MSTFactory::StaticContext<BoruvkaSolver> parallel(std::in_place, 4u);
+    check(parallel.computeMST<WeightMetrics>(graph).totalWeight == whole.totalWeight, "batched parallel solver finds the same weight");
+
+    Graph connected = fragmentedGraph(1, 400, 800);
+    context.computeMST(connected);
+    check(context.getSolver().lastBatchCount() == 1, "static context solves a connected graph whole");
+}
+
+// An edge of the largest weight is still an edge: every solver spans {0-1: max, 1-2: 5} with both
+// edges, though the weight doubles as the "no edge" mark of some solvers
+static void testMaxWeightEdge()
+{
+    const Weight heaviest = std::numeric_limits<Weight>::max();
+    Graph graph(3);
+    graph.addEdge(0, 1, heaviest);
+    graph.addEdge(1, 2, 5);
+    for (MSTAlgorithmType type : {MSTAlgorithmType::Prim, MSTAlgorithmType::HeapPrim, MSTAlgorithmType::PrimDense,
+                                  MSTAlgorithmType::Kruskal, MSTAlgorithmType::Boruvka, MSTAlgorithmType::FilterKruskal,
+                                  MSTAlgorithmType::RadixKruskal, MSTAlgorithmType::LazyKruskal})
+    {
+        std::string name = algorithmTypeToString(type);
+        std::shared_ptr<const MSTResult> result = MSTFactory::solve(type, MSTMetrics::All, graph);
+        check(result->mstEdges.size() == 2 && result->componentCount == 1 &&
+                  result->totalWeight == static_cast<Distance>(heaviest) + 5,
+              name + " spans a graph with an edge of the largest weight");
+    }
+
+    // The forest of a fragmented graph keeps its max-weight edges inside the components
+    Graph forest(5);
+    forest.addEdge(0, 1, heaviest);
+    forest.addEdge(1, 2, 5);
+    forest.addEdge(3, 4, heaviest);
+    std::shared_ptr<const MSTResult> result = MSTFactory::solve(MSTAlgorithmType::Prim, MSTMetrics::All, forest);
+    check(result->mstEdges.size() == 3 && result->componentCount == 2 && result->components.size() == 2 &&
+              result->components[0].vertexCount + result->components[1].vertexCount == 5,
+          "Prim keeps the max-weight edges of a forest inside its components");
+}
+
+// The reordering solvers of a thread share one cached relabeling: switching the ordering, the
+// algorithm or the graph version between solves still renames the MST back correctly
+static void testReorderingCache()
+{
+    Graph graph = fragmentedGraph(1, 300, 900);
+    Distance expected = KruskalSolver().computeMSTEdges(graph).totalWeight();
+    ReorderingSolver bfs(std::make_unique<KruskalSolver>(), VertexOrdering::Bfs);
+    ReorderingSolver rcm(std::make_unique<HeapPrimSolver>(), VertexOrdering::ReverseCuthillMcKee);
+    bool same = true;
+    for (int round = 0; round < 2; ++round)
+        same = same && bfs.computeMSTEdges(graph).totalWeight() == expected &&
+               rcm.computeMSTEdges(graph).totalWeight() == expected;
+    for (VertexOrdering ordering : {VertexOrdering::Bfs, VertexOrdering::ReverseCuthillMcKee})
+        same = same && MSTFactory::solve(MSTAlgorithmType::Prim, MSTMetrics::Weight, graph, ordering)->totalWeight == expected;
+    check(same, "reordering solvers sharing the thread's relabeling find the MST weight");
+
+    graph.addEdge(0, 299, 0);
+    EdgeList mst = rcm.computeMSTEdges(graph);
+    bool hasNewEdge = false;
+    for (std::size_t i = 0; i < mst.size(); ++i)
+        hasNewEdge = hasNewEdge || (std::min(mst.from[i], mst.to[i]) == 0 && std::max(mst.from[i], mst.to[i]) == 299);
+    check(hasNewEdge && mst.totalWeight() == KruskalSolver().computeMSTEdges(graph).totalWeight(),
+          "a new graph version is relabeled again");
+}
+
+// Starts ./server_program on 'port', answering its port prompt; its output is discarded
+static pid_t startServer(int port)
+{
+    int input[2];
+    if (pipe(input) < 0)
+        return -1;
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        dup2(input[0], STDIN_FILENO);
+        int discard = open("/dev/null", O_WRONLY);
+        dup2(discard, STDOUT_FILENO);
+        close(input[1]);
+        execl("./server_program", "server_program", static_cast<char *>(nullptr));
+        _exit(127);
+    }
+    close(input[0]);
+    std::string line = std::to_string(port) + "\n";
+    if (write(input[1], line.data(), line.size()) < 0)
+        std::cerr << "Could not send the port to the server" << std::endl;
+    close(input[1]);
+    return pid;
+}
+
+// Connects to the local server, waiting up to five seconds for it to listen
+static int connectToServer(int port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for (int attempt = 0; attempt < 50; ++attempt)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+            return fd;
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return -1;
+}
+
+static bool sendAll(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t bytes = send(fd, data, length, MSG_NOSIGNAL);
+        if (bytes <= 0)
+            return false;
+        data += bytes;
+        length -= bytes;
+    }
+    return true;
+}
+
+// Sends one text command, then gives the server time to read it on its own
+static bool sendCommand(int fd, const std::string &command)
+{
+    bool sent = sendAll(fd, command.data(), command.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    return sent;
+}
+
+// Receives one length-prefixed response, "" if the connection closed first
+static std::string receiveResponse(int fd)
+{
+    int32_t length = 0;
+    std::string response;
+    if (recv(fd, &length, sizeof(length), MSG_WAITALL) != sizeof(length) || length < 0)
+        return response;
+    response.resize(length);
+    if (recv(fd, &response[0], length, MSG_WAITALL) != length)
+        return "";
+    return response;
+}
+
+// The total weight line of a SolveMST response ends with the weight
+static bool reportsWeight(const std::string &response, Distance weight)
+{
+    std::size_t start = response.find("Total weight");
+    if (start == std::string::npos)
+        return false;
+    std::string line = response.substr(start, response.find('\n', start) - start);
+    std::string expected = " " + std::to_string(weight);
+    return line.size() >= expected.size() && line.compare(line.size() - expected.size(), expected.size(), expected) == 0;
+}
+
+// An AddEdges block with an edge count the server rejects is read and dropped whole, so the text
+// commands after it are still understood. A negative count closes the connection.
+static void testRejectedBulkBlockIsDrained()
+{
+    int port = 20000 + getpid() % 20000;
+    pid_t server = startServer(port);
+    int fd = server > 0 ? connectToServer(port) : -1;
+    check(fd >= 0, "server accepts a connection");
+    if (fd < 0)
+    {
+        if (server > 0)
+            kill(server, SIGKILL);
+        return;
+    }
+
+    // The payload is spaces with NewGraph commands near its end: a server that parsed it as text
+    // would replace the graph and lose the edge added before the block
+    int32_t count = MAX_BULK_EDGES + 1;
+    std::string header = "AddEdges";
+    header.append(reinterpret_cast<const char *>(&count), sizeof(count));
+    const size_t payloadLength = 3 * static_cast<size_t>(count) * sizeof(int32_t);
+    std::string tail(1 << 14, ' ');
+    for (size_t at = 1000; at + 10 < tail.size(); at += 1500)
+        tail.replace(at, 10, "NewGraph 2");
+    std::vector<char> spaces(1 << 16, ' ');
+    bool sent = sendCommand(fd, "NewGraph 2") && sendCommand(fd, "AddEdge 0 1 5") && sendAll(fd, header.data(), header.size());
+    for (size_t left = payloadLength - tail.size(); sent && left > 0; left -= std::min(left, spaces.size()))
+        sent = sendAll(fd, spaces.data(), std::min(left, spaces.size()));
+    sent = sent && sendAll(fd, tail.data(), tail.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    sent = sent && sendCommand(fd, "AddEdge 0 1 7") && sendCommand(fd, "SolveMST Kruskal");
+    check(sent, "server reads an oversized AddEdges block to its end");
+    check(sent && reportsWeight(receiveResponse(fd), 5), "commands after an oversized AddEdges block are understood");
+    close(fd);
+
+    fd = connectToServer(port);
+    count = -1;
+    header = "AddEdges";
+    header.append(reinterpret_cast<const char *>(&count), sizeof(count));
+    sent = fd >= 0 && sendCommand(fd, "NewGraph 2") && sendCommand(fd, header + "AddEdge 0 1 5");
+    sendCommand(fd, "SolveMST Kruskal");
+    check(sent && receiveResponse(fd).empty(), "an AddEdges block with a negative count closes the connection");
+    if (fd >= 0)
+        close(fd);
+
+    kill(server, SIGKILL);
+    waitpid(server, nullptr, 0);
+}
+
+int main()
+{
+    testStaticContextSplitsComponents();
+    testMaxWeightEdge();
+    testReorderingCache();
+    testRejectedBulkBlockIsDrained();
+    std::cout << (failures ? std::to_string(failures) + " check(s) failed" : std::string("All checks passed")) << std::endl;
+    return failures;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Number of threads worth using for 'work' items: one per hardware thread,
+// but no fewer than 'minPerThread' items each, so small inputs stay on one thread
+inline unsigned threadCountFor(std::size_t work, std::size_t minPerThread = 1 << 15)
+{
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min(hardware, work / minPerThread)));
+}
+
+// Splits [0, count) into 'threads' contiguous ranges and runs body(begin, end, thread) on each.
+// The last range runs on the calling thread; returns once every range is done.
+template <typename Body>
+void parallelFor(std::size_t count, unsigned threads, Body &&body)
+{
+    threads = std::max(1u, threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 0; t + 1 < threads; ++t)
+        workers.emplace_back([&body, count, threads, t]()
+                             { body(count * t / threads, count * (t + 1) / threads, t); });
+    body(count * (threads - 1) / threads, count, threads - 1);
+    for (std::thread &worker : workers)
+        worker.join();
+}
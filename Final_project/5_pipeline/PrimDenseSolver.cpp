@@ -0,0 +1,90 @@
+#include "PrimDenseSolver.hpp"
+#include "HeapPrimSolver.hpp"
+#include "AdjacencyMatrix.hpp"
+#include <vector>
+
+namespace
+{
+    constexpr Weight NO_EDGE = AdjacencyMatrixView::NO_EDGE;
+
+    // Smallest key, with the same branchless select on every element so the loop vectorizes
+    Weight minKey(const Weight *key, int count)
+    {
+        Weight best = NO_EDGE;
+        for (int v = 0; v < count; ++v)
+            best = key[v] < best ? key[v] : best;
+        return best;
+    }
+
+    // First vertex outside the tree whose key is 'value' and that has an edge to the tree, -1 if
+    // none. The edge ID tells a real edge of weight NO_EDGE from the absence of an edge.
+    int findKey(const Weight *key, const int *edgeId, const char *done, int count, Weight value)
+    {
+        for (int v = 0; v < count; ++v)
+            if (key[v] == value && edgeId[v] >= 0 && !done[v])
+                return v;
+        return -1;
+    }
+}
+
+EdgeList PrimDenseSolver::computeMSTEdges(const Graph &graph)
+{
+    int vertexCount = graph.getVertexCount();
+    if (vertexCount > MAX_VERTICES)
+    {
+        if (!sparseSolver)
+            sparseSolver = std::make_unique<HeapPrimSolver>();
+        return sparseSolver->computeMSTEdges(graph);
+    }
+
+    // Built per solve rather than kept with the graph: a cached matrix would pin up to
+    // MATRIX_BUDGET_BYTES for every graph version until its next edit
+    AdjacencyMatrix dense = AdjacencyMatrix::build(graph.getEdges(), vertexCount);
+    AdjacencyMatrixView matrix = dense.view();
+
+    // key[v] is the weight of the lightest edge from the tree to v, and edgeId[v] its ID, -1 while v
+    // has no edge to the tree. Vertices in the tree are parked at NO_EDGE so the reduction skips them;
+    // 'done' keeps the relaxation from touching them again.
+    key.assign(vertexCount, NO_EDGE);
+    parent.assign(vertexCount, 0);
+    edgeId.assign(vertexCount, -1);
+    done.assign(vertexCount, 0);
+    EdgeList mst;
+    mst.reserve(vertexCount > 0 ? vertexCount - 1 : 0);
+
+    int nextRoot = 0;
+    for (int added = 0; added < vertexCount; ++added)
+    {
+        // The next vertex is the closest one to the tree, or a new root once the component is complete.
+        // A smallest key of NO_EDGE can still be an edge of that weight, so the edge IDs decide.
+        Weight best = minKey(key.data(), vertexCount);
+        int v = findKey(key.data(), edgeId.data(), done.data(), vertexCount, best);
+        if (v < 0)
+        {
+            while (done[nextRoot])
+                ++nextRoot;
+            v = nextRoot;
+        }
+        else
+            mst.push_back(parent[v], static_cast<VertexId>(v), best, edgeId[v]);
+        done[v] = 1;
+        key[v] = NO_EDGE;
+
+        // Relax the row of v; a vertex without an edge to the tree takes any edge, even one weighing
+        // NO_EDGE. Every element is loaded and stored unconditionally, so the loop has no branch and
+        // vectorizes as well.
+        const Weight *weights = matrix.weightRow(v);
+        const int *ids = matrix.idRow(v);
+        for (int u = 0; u < vertexCount; ++u)
+        {
+            Weight w = weights[u], k = key[u];
+            VertexId p = parent[u];
+            int id = ids[u], e = edgeId[u];
+            bool closer = ((w < k) | ((id >= 0) & (e < 0))) & (done[u] == 0);
+            key[u] = closer ? w : k;
+            parent[u] = closer ? static_cast<VertexId>(v) : p;
+            edgeId[u] = closer ? id : e;
+        }
+    }
+    return mst;
+}
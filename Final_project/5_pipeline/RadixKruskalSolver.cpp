@@ -0,0 +1,125 @@
+#include "RadixKruskalSolver.hpp"
+#include "Parallel.hpp"
+#include <cstring>
+
+namespace
+{
+    using Key = RadixKruskalSolver::Key;
+    using Histogram = RadixKruskalSolver::Histogram;
+    constexpr int RADIX_BITS = RadixKruskalSolver::RADIX_BITS;
+    constexpr int BUCKETS = RadixKruskalSolver::BUCKETS;
+
+    // Unsigned key with the same order as the weight: the sign bit of an integer is flipped,
+    // and a negative floating point value has all its bits flipped
+    template <typename W>
+    Key radixKey(W weight)
+    {
+        constexpr int bits = sizeof(W) * 8;
+        if constexpr (std::is_floating_point_v<W>)
+        {
+            using Bits = std::conditional_t<sizeof(W) == 4, std::uint32_t, std::uint64_t>;
+            Bits b;
+            std::memcpy(&b, &weight, sizeof(b));
+            return static_cast<Key>(b >> (bits - 1) ? ~b : b | (Bits(1) << (bits - 1)));
+        }
+        else
+        {
+            using Bits = std::make_unsigned_t<W>;
+            Bits b = static_cast<Bits>(weight);
+            if constexpr (std::is_signed_v<W>)
+                b ^= Bits(1) << (bits - 1);
+            return static_cast<Key>(b);
+        }
+    }
+
+    int digit(Key key, int pass)
+    {
+        return static_cast<int>((key >> (pass * RADIX_BITS)) & (BUCKETS - 1));
+    }
+}
+
+// Stable LSD radix sort of the edge indices by key, one byte per pass
+void RadixKruskalSolver::radixSort(unsigned threads)
+{
+    std::size_t count = keys.size();
+    keyBuffer.resize(count);
+    orderBuffer.resize(count);
+    histograms.resize(threads);
+
+    // A pass is skipped when every key has the same byte there, e.g. the high bytes of small weights
+    Key all = 0, any = 0;
+    if (count > 0)
+    {
+        all = keys[0];
+        for (Key key : keys)
+            any |= key ^ all;
+    }
+
+    for (int pass = 0; pass < static_cast<int>(sizeof(Weight)); ++pass)
+    {
+        if (digit(any, pass) == 0)
+            continue;
+
+        parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned t)
+                    {
+            Histogram &histogram = histograms[t];
+            histogram.fill(0);
+            for (std::size_t i = begin; i < end; ++i)
+                ++histogram[digit(keys[i], pass)]; });
+
+        // Bucket b of thread t starts after all smaller buckets, and after bucket b of lower threads
+        std::size_t offset = 0;
+        for (int b = 0; b < BUCKETS; ++b)
+        {
+            for (Histogram &histogram : histograms)
+            {
+                std::size_t size = histogram[b];
+                histogram[b] = offset;
+                offset += size;
+            }
+        }
+
+        parallelFor(count, threads, [&](std::size_t begin, std::size_t end, unsigned t)
+                    {
+            Histogram &next = histograms[t];
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t slot = next[digit(keys[i], pass)]++;
+                keyBuffer[slot] = keys[i];
+                orderBuffer[slot] = order[i];
+            } });
+        keys.swap(keyBuffer);
+        order.swap(orderBuffer);
+    }
+}
+
+EdgeList RadixKruskalSolver::computeMSTEdges(const Graph &graph)
+{
+    EdgeView edges = graph.getEdges();
+    unsigned threadCount = threads ? threads : threadCountFor(edges.size());
+    uf.reset(graph.getVertexCount());
+    EdgeList mst;
+    mst.reserve(graph.getVertexCount() > 0 ? graph.getVertexCount() - 1 : 0);
+
+    keys.resize(edges.size());
+    order.resize(edges.size());
+    parallelFor(edges.size(), threadCount, [&](std::size_t begin, std::size_t end, unsigned)
+                {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            keys[i] = radixKey(edges.weight[i]);
+            order[i] = static_cast<int>(i);
+        } });
+    radixSort(threadCount);
+
+    // Add edges if they don’t form a cycle
+    for (int index : order)
+    {
+        if (uf.unite(edges.from[index], edges.to[index]))
+        {
+            mst.push_back(edges.from[index], edges.to[index], edges.weight[index], edges.id[index]);
+        }
+    }
+
+    return mst;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "union_find.hpp"
+
+// Kruskal's algorithm with the edges ordered by an LSD radix sort of (weight key, edge index)
+// instead of a comparison sort: O(E) per byte of Weight, and byte positions on which all the
+// weights agree are skipped. Large inputs are counted and scattered on several threads.
+class RadixKruskalSolver : public MSTSolver
+{
+public:
+    // Unsigned sort key of a weight, and the counts of one byte of the keys
+    using Key = std::conditional_t<sizeof(Weight) <= sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+    static constexpr int RADIX_BITS = 8;
+    static constexpr int BUCKETS = 1 << RADIX_BITS;
+    using Histogram = std::array<std::size_t, BUCKETS>;
+
+    // threads = 0 picks a thread count from the edge count and the hardware
+    explicit RadixKruskalSolver(unsigned threads = 0) : threads(threads) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    unsigned threads;
+    SparseUnionFind uf{0};
+    std::vector<Key> keys, keyBuffer;    // Sort keys, and the buffer every pass scatters them into
+    std::vector<int> order, orderBuffer; // Edge indices in the order of the keys, and their buffer
+    std::vector<Histogram> histograms;   // One per thread
+
+    void radixSort(unsigned threadCount);
+};
@@ -0,0 +1,46 @@
+#include "ReorderingSolver.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    // The last relabeling of the calling thread, replaced by the next one of another version or ordering
+    struct Relabeling
+    {
+        std::uint64_t version = 0;
+        VertexOrdering ordering = VertexOrdering::None;
+        std::vector<VertexId> order;      // order[k] is the original ID of vertex k of 'graph'
+        std::unique_ptr<Graph> graph;     // Keeps its CSR too, once a solver has built it
+    };
+
+    thread_local Relabeling lastRelabeling;
+}
+
+EdgeList solveReordered(const Graph &graph, VertexOrdering ordering, const std::function<EdgeList(const Graph &)> &solve)
+{
+    // Relabel in O(V + E) when the graph version or the ordering changed, solve on the relabeled
+    // copy, then rename the MST's vertices back. The old copy is freed before the new one is built.
+    Relabeling &cached = lastRelabeling;
+    if (!cached.graph || cached.version != graph.getVersion() || cached.ordering != ordering)
+    {
+        cached.graph.reset();
+        cached.order = computeVertexOrder(graph.getAdjacency(), ordering);
+        cached.graph = graph.relabeled(cached.order);
+        cached.version = graph.getVersion();
+        cached.ordering = ordering;
+    }
+
+    EdgeList mst = solve(*cached.graph);
+    for (std::size_t i = 0; i < mst.size(); ++i)
+    {
+        mst.from[i] = cached.order[mst.from[i]];
+        mst.to[i] = cached.order[mst.to[i]];
+    }
+    return mst;
+}
+
+EdgeList ReorderingSolver::computeMSTEdges(const Graph &graph)
+{
+    return solveReordered(graph, ordering, [this](const Graph &relabeled)
+                          { return solver->computeMSTEdges(relabeled); });
+}
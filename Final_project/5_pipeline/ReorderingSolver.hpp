@@ -0,0 +1,27 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include "MSTSolver.hpp"
+#include "MSTResult.hpp"
+#include "VertexOrdering.hpp"
+
+// Solves a copy of 'graph' whose vertices were relabeled in 'ordering' for locality with
+// solve(copy), then maps the MST edges back to the original vertex IDs. The order and the
+// relabeled copy are kept for the graph version and ordering they were computed for, so solving
+// the same version again only costs the solve and the renaming of the MST. All the reordered
+// solves of a thread share that cache: a thread holds at most one relabeled copy.
+EdgeList solveReordered(const Graph &graph, VertexOrdering ordering, const std::function<EdgeList(const Graph &)> &solve);
+
+// Runs another solver on the graph relabeled for locality (see solveReordered)
+class ReorderingSolver : public MSTSolver
+{
+public:
+    ReorderingSolver(std::unique_ptr<MSTSolver> solver, VertexOrdering ordering)
+        : solver(std::move(solver)), ordering(ordering) {}
+
+    EdgeList computeMSTEdges(const Graph &graph) override;
+
+private:
+    std::unique_ptr<MSTSolver> solver;
+    VertexOrdering ordering;
+};
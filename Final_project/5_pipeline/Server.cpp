@@ -5,6 +5,7 @@
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <algorithm>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <signal.h>
@@ -12,6 +13,10 @@
 #include <mutex>
 #include <map>
 
+// Binary bulk edge command: the bytes "AddEdges", an int32 edge count, then count (from, to, weight) int32 triples
+static const char BULK_EDGES_COMMAND[] = "AddEdges";
+static const int BULK_EDGES_COMMAND_LENGTH = sizeof(BULK_EDGES_COMMAND) - 1;
+
 /**
  * @brief Initializes the PAO pipeline with task functions for MST processing.
  */
@@ -29,7 +34,7 @@ void initializePAO()
         [](void *taskPtr)
         {
             Triple *task = static_cast<Triple *>(taskPtr);
-            if (task->mstGraph)
+            if (task->mstGraph && hasDistances(task->metrics))
             {
                 task->msg += "Longest path in MST: " + std::to_string(task->mstGraph->longestDistance) + "\n";
             }
@@ -37,7 +42,7 @@ void initializePAO()
         [](void *taskPtr)
         {
             Triple *task = static_cast<Triple *>(taskPtr);
-            if (task->mstGraph)
+            if (task->mstGraph && hasDistances(task->metrics))
             {
                 task->msg += "Average distance in MST: " + std::to_string(task->mstGraph->averageDistance) + "\n";
             }
@@ -45,7 +50,22 @@ void initializePAO()
         [](void *taskPtr)
         {
             Triple *task = static_cast<Triple *>(taskPtr);
-            if (task->mstGraph)
+            if (task->mstGraph && hasComponents(task->metrics))
+            {
+                task->msg += "Components of MST forest: " + std::to_string(task->mstGraph->componentCount) + "\n";
+                for (std::size_t k = 0; k < task->mstGraph->components.size(); ++k)
+                {
+                    const ComponentStats &component = task->mstGraph->components[k];
+                    task->msg += "Component " + std::to_string(k) + ": " + std::to_string(component.vertexCount) +
+                                 " vertices, weight " + std::to_string(component.totalWeight) +
+                                 ", diameter " + std::to_string(component.diameter) + "\n";
+                }
+            }
+        },
+        [](void *taskPtr)
+        {
+            Triple *task = static_cast<Triple *>(taskPtr);
+            if (task->mstGraph && hasDistances(task->metrics))
             {
                 task->msg += "Shortest paths in MST:\n";
                 for (const auto &row : task->mstGraph->shortestDistances)
@@ -62,9 +82,10 @@ void initializePAO()
         {
             Triple *task = static_cast<Triple *>(taskPtr);
             std::ostringstream response;
-            for (const auto &[from, to, weight, id] : task->mstGraph->mstEdges)
+            const EdgeList &edges = task->mstGraph->mstEdges;
+            for (std::size_t i = 0; i < edges.size(); ++i)
             {
-                response << "Edge from " << from << " to " << to << " with weight " << weight << "\n";
+                response << "Edge from " << edges.from[i] << " to " << edges.to[i] << " with weight " << edges.weight[i] << "\n";
             }
 
             response << "\nFinal pipeline data:\n";
@@ -179,6 +200,45 @@ void Server::stop()
     }
 }
 
+/**
+ * @brief Reads exactly the requested number of bytes from a socket.
+ * @param socket The socket file descriptor.
+ * @param data Destination buffer.
+ * @param length Number of bytes to read.
+ * @return False if the connection closed before all bytes arrived.
+ */
+static bool readFully(int socket, char *data, size_t length)
+{
+    size_t total = 0;
+    while (total < length)
+    {
+        ssize_t bytes = read(socket, data + total, length - total);
+        if (bytes <= 0)
+            return false;
+        total += bytes;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads and drops exactly 'length' bytes from a socket.
+ * @param socket The socket file descriptor.
+ * @param length Number of bytes to drop.
+ * @return False if the connection closed or failed first.
+ */
+static bool skipFully(int socket, size_t length)
+{
+    char discarded[4096];
+    while (length > 0)
+    {
+        ssize_t bytes = read(socket, discarded, std::min(length, sizeof(discarded)));
+        if (bytes <= 0)
+            return false;
+        length -= bytes;
+    }
+    return true;
+}
+
 /**
  * @brief Handles communication with a client.
  * @param client_socket The client's socket file descriptor.
@@ -191,10 +251,71 @@ void Server::handleClient(int client_socket)
     while ((bytes_read = read(client_socket, buffer, sizeof(buffer) - 1)) > 0)
     {
         buffer[bytes_read] = '\0';
-        processRequest(client_socket, buffer);
+        std::string request(buffer, bytes_read);
+
+        // Binary blocks can't go through the text parser; whatever follows the block is a regular request
+        bool open = true;
+        while (open && request.compare(0, BULK_EDGES_COMMAND_LENGTH, BULK_EDGES_COMMAND) == 0)
+            open = receiveBulkEdges(client_socket, request);
+        if (!open)
+            break;
+
+        if (!request.empty())
+            processRequest(client_socket, request);
     }
 
     close(client_socket);
+    resultCache.eraseClient(client_socket);
+}
+
+/**
+ * @brief Completes an AddEdges block and adds its edges to the client's graph.
+ *
+ * A block of more than MAX_BULK_EDGES edges is read and dropped, so the next command is still
+ * found where it starts. A negative edge count leaves the end of the block unknown, and the
+ * connection is closed.
+ * @param client_socket The client's socket file descriptor.
+ * @param request The bytes of the block that were already read; replaced by the bytes received after its end.
+ * @return False if the connection must be closed.
+ */
+bool Server::receiveBulkEdges(int client_socket, std::string &request)
+{
+    const size_t headerLength = BULK_EDGES_COMMAND_LENGTH + sizeof(int32_t);
+    size_t length = request.size();
+    std::vector<char> header(request.begin(), request.begin() + std::min(length, headerLength));
+    header.resize(headerLength);
+    if (length < headerLength && !readFully(client_socket, header.data() + length, headerLength - length))
+        return false;
+
+    int32_t count;
+    std::memcpy(&count, header.data() + BULK_EDGES_COMMAND_LENGTH, sizeof(count));
+    if (count < 0)
+    {
+        safePrint("Closing the connection of client " + std::to_string(client_socket) + " after an AddEdges block with edge count " + std::to_string(count));
+        return false;
+    }
+
+    size_t payloadLength = 3 * static_cast<size_t>(count) * sizeof(int32_t);
+    size_t buffered = length > headerLength ? std::min(length - headerLength, payloadLength) : 0;
+    if (count > MAX_BULK_EDGES)
+    {
+        safePrint("Rejected AddEdges block of " + std::to_string(count) + " edges from client " + std::to_string(client_socket) +
+                  ", the limit is " + std::to_string(MAX_BULK_EDGES));
+        if (!skipFully(client_socket, payloadLength - buffered))
+            return false;
+    }
+    else
+    {
+        // Copy the part of the payload that arrived with the header, then read the rest
+        std::vector<int32_t> triples(3 * static_cast<size_t>(count));
+        std::memcpy(triples.data(), request.data() + headerLength, buffered);
+        if (!readFully(client_socket, reinterpret_cast<char *>(triples.data()) + buffered, payloadLength - buffered))
+            return false;
+        addEdges(client_socket, triples);
+    }
+
+    request.erase(0, std::min(length, headerLength + buffered));
+    return true;
 }
 
 /**
@@ -210,13 +331,14 @@ void Server::processRequest(int client_socket, const std::string &request)
 
     if (command == "NewGraph")
     {
-        int n;
+        long long n;
         iss >> n;
         addGraph(client_socket, n);
     }
     else if (command == "AddEdge")
     {
-        int i, j, weight;
+        int i, j;
+        Weight weight;
         iss >> i >> j >> weight;
         addEdge(client_socket, i, j, weight);
     }
@@ -226,24 +348,144 @@ void Server::processRequest(int client_socket, const std::string &request)
         iss >> i >> j;
         removeEdge(client_socket, i, j);
     }
+    else if (command == "LoadGraph")
+    {
+        std::string path;
+        iss >> path;
+        loadGraph(client_socket, path);
+    }
+    else if (command == "SaveGraph")
+    {
+        std::string path;
+        iss >> path;
+        saveGraph(client_socket, path);
+    }
+    else if (command == "ImportGraph")
+    {
+        std::string path, format, option;
+        iss >> path >> format >> option;
+        importGraph(client_socket, path, format, option == "collapse");
+    }
     else if (command == "SolveMST")
     {
-        std::string algorithm;
+        // SolveMST <algorithm> [BFS|RCM] [All|Weight|Components|Distances]
+        std::string algorithm, option;
         iss >> algorithm;
+        VertexOrdering ordering = VertexOrdering::None;
+        MSTMetrics metrics = MSTMetrics::All;
+        while (iss >> option)
+        {
+            if (stringToMSTMetrics(option) != MSTMetrics::Invalid)
+                metrics = stringToMSTMetrics(option);
+            else
+                ordering = stringToVertexOrdering(option);
+        }
         MSTAlgorithmType algoType = stringToAlgorithmType(algorithm);
-        solveMSTWithPipeline(client_socket, algoType, algorithm);
+        solveMSTWithPipeline(client_socket, algoType, algorithm, ordering, metrics);
     }
 }
 
+/**
+ * @brief Returns the client's graph ready for an in-place edit.
+ *
+ * A version that is still pinned by a running solve or save is never modified: it is copied first
+ * and the copy becomes the current version, with no pins. Must be called with graph_mutex held.
+ * @param client_id The client ID.
+ * @return The current, unpinned version of the client's graph.
+ */
+Graph &Server::editableGraph(int client_id)
+{
+    auto &graph = clientGraphs[client_id];
+    if (!graph)
+        graph = std::make_shared<Graph>();
+    else if (graphPins[client_id] > 0)
+    {
+        graph = std::make_shared<Graph>(*graph);
+        graphPins.erase(client_id);
+    }
+    return *graph;
+}
+
+/**
+ * @brief Pins the client's current graph version so it can be read without holding graph_mutex.
+ *
+ * The pin count, not the shared_ptr's use count, is what keeps edits from modifying a version in
+ * place: it is only changed under the lock. Must be called with graph_mutex held.
+ * @param client_id The client ID.
+ * @return The pinned version, or nullptr if the client has no graph.
+ */
+std::shared_ptr<const Graph> Server::pinGraph(int client_id)
+{
+    auto it = clientGraphs.find(client_id);
+    if (it == clientGraphs.end() || !it->second)
+        return nullptr;
+    ++graphPins[client_id];
+    return it->second;
+}
+
+/**
+ * @brief Releases a pin taken by pinGraph. Once the version was copied or replaced, its pins are gone.
+ * @param client_id The client ID.
+ * @param graph The pinned version.
+ */
+void Server::releaseGraph(int client_id, const std::shared_ptr<const Graph> &graph)
+{
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    auto it = clientGraphs.find(client_id);
+    if (graph && it != clientGraphs.end() && it->second == graph)
+        --graphPins[client_id];
+}
+
+/**
+ * @brief Feeds the last added edges of the client's graph to its maintained MST, if it has one.
+ * Must be called with graph_mutex held, right after the edges were added.
+ * @param client_id The client ID.
+ * @param added Number of edges just added.
+ */
+void Server::updateMaintainedMST(int client_id, std::size_t added)
+{
+    auto it = maintainedMSTs.find(client_id);
+    if (it == maintainedMSTs.end())
+        return;
+
+    EdgeView edges = clientGraphs[client_id]->getEdges();
+    for (std::size_t i = edges.size() - added; i < edges.size(); ++i)
+        it->second->addEdge(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+}
+
+/**
+ * @brief Puts back a maintained MST that was updated outside graph_mutex, on the pinned version it
+ * belongs to. It is dropped if the graph has moved on meanwhile; the next SolveMST then builds a new one.
+ * @param client_id The client ID.
+ * @param graph The pinned version the MST was updated for.
+ * @param dynamic The updated MST.
+ */
+void Server::reinstallMaintainedMST(int client_id, const std::shared_ptr<const Graph> &graph, std::unique_ptr<DynamicMST> dynamic)
+{
+    std::lock_guard<std::mutex> lock(graph_mutex);
+    auto it = clientGraphs.find(client_id);
+    if (it != clientGraphs.end() && it->second == graph && !maintainedMSTs.count(client_id))
+        maintainedMSTs[client_id] = std::move(dynamic);
+}
+
 /**
  * @brief Creates a new graph for the client.
  * @param client_id The client ID.
  * @param n The number of vertices in the graph.
  */
-void Server::addGraph(int client_id, int n)
+void Server::addGraph(int client_id, long long n)
 {
+    if (n < 0 || n > MAX_VERTEX_COUNT)
+    {
+        safePrint("Rejected graph with " + std::to_string(n) + " vertices for client " + std::to_string(client_id) +
+                  ", this build supports up to " + std::to_string(MAX_VERTEX_COUNT) + " vertices");
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(graph_mutex);
-    clientGraphs[client_id] = Graph(n);
+    clientGraphs[client_id] = std::make_shared<Graph>(static_cast<int>(n));
+    maintainedMSTs.erase(client_id);
+    graphPins.erase(client_id);
     safePrint("New graph created with " + std::to_string(n) + " vertices for client " + std::to_string(client_id));
 }
 
@@ -254,72 +496,273 @@ void Server::addGraph(int client_id, int n)
  * @param j The second vertex.
  * @param weight The edge weight.
  */
-void Server::addEdge(int client_id, int i, int j, int weight)
+void Server::addEdge(int client_id, int i, int j, Weight weight)
 {
     std::lock_guard<std::mutex> lock(graph_mutex);
-    clientGraphs[client_id].addEdge(i, j, weight);
-    safePrint("Added edge (" + std::to_string(i) + ", " + std::to_string(j) + ") with weight " + std::to_string(weight) + " for client " + std::to_string(client_id));
+    if (editableGraph(client_id).addEdge(i, j, weight))
+    {
+        updateMaintainedMST(client_id, 1);
+        safePrint("Added edge (" + std::to_string(i) + ", " + std::to_string(j) + ") with weight " + std::to_string(weight) + " for client " + std::to_string(client_id));
+    }
+    else
+        safePrint("Rejected edge (" + std::to_string(i) + ", " + std::to_string(j) + ") with out-of-range vertices for client " + std::to_string(client_id));
+}
+
+/**
+ * @brief Adds a block of edges to the client's graph under a single lock acquisition.
+ *
+ * A block can hold millions of edges, each an O(log V) update of the maintained MST. Like the
+ * replacement search of removeEdge, those run outside graph_mutex, on the MST taken out of
+ * maintainedMSTs and the pinned version holding the block.
+ * @param client_id The client ID.
+ * @param triples Flattened (from, to, weight) triples.
+ */
+void Server::addEdges(int client_id, const std::vector<int32_t> &triples)
+{
+    size_t count = triples.size() / 3;
+    std::unique_ptr<DynamicMST> dynamic;
+    std::shared_ptr<const Graph> graph;
+    bool added;
+    {
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        added = editableGraph(client_id).addEdges(triples.data(), count);
+        auto it = maintainedMSTs.find(client_id);
+        if (added && it != maintainedMSTs.end())
+        {
+            dynamic = std::move(it->second);
+            maintainedMSTs.erase(it);
+            graph = pinGraph(client_id);
+        }
+    }
+    if (dynamic)
+    {
+        EdgeView edges = graph->getEdges();
+        for (std::size_t i = edges.size() - count; i < edges.size(); ++i)
+            dynamic->addEdge(edges.from[i], edges.to[i], edges.weight[i], edges.id[i]);
+        reinstallMaintainedMST(client_id, graph, std::move(dynamic));
+        releaseGraph(client_id, graph);
+    }
+    if (added)
+        safePrint("Added " + std::to_string(count) + " edges for client " + std::to_string(client_id));
+    else
+        safePrint("Rejected block of " + std::to_string(count) + " edges with out-of-range vertices for client " + std::to_string(client_id));
 }
 
 /**
  * @brief Removes an edge from the client's graph.
+ *
+ * Removing a tree edge makes the maintained MST search for a replacement, and index the non-tree
+ * edges the first time. That runs outside graph_mutex, on the MST taken out of maintainedMSTs and
+ * the pinned version it belongs to (see reinstallMaintainedMST).
  * @param client_id The client ID.
  * @param i The first vertex.
  * @param j The second vertex.
  */
 void Server::removeEdge(int client_id, int i, int j)
 {
-    std::lock_guard<std::mutex> lock(graph_mutex);
-    clientGraphs[client_id].removeEdge(i, j);
+    std::unique_ptr<DynamicMST> dynamic;
+    std::shared_ptr<const Graph> graph;
+    std::vector<int> removed;
+    {
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        removed = editableGraph(client_id).removeEdge(i, j);
+        auto it = maintainedMSTs.find(client_id);
+        if (it != maintainedMSTs.end())
+        {
+            if (!it->second->touchesForest(removed))
+                it->second->removeEdges(removed, *clientGraphs[client_id]);
+            else
+            {
+                dynamic = std::move(it->second);
+                maintainedMSTs.erase(it);
+                graph = pinGraph(client_id);
+            }
+        }
+    }
+    if (dynamic)
+    {
+        dynamic->removeEdges(removed, *graph);
+        reinstallMaintainedMST(client_id, graph, std::move(dynamic));
+        releaseGraph(client_id, graph);
+    }
     safePrint("Removed edge (" + std::to_string(i) + ", " + std::to_string(j) + ") for client " + std::to_string(client_id));
 }
 
 /**
- * @brief Solves the MST and processes the result using the PAO pipeline.
- * @param client_socket The client's socket file descriptor.
- * @param algoType The MST algorithm to use.
- * @param algorithm The name of the algorithm.
+ * @brief Replaces the client's graph with a graph parsed from a text file.
+ * @param client_id The client ID.
+ * @param path Path of the text file.
+ * @param format "edgelist", "dimacs" or "metis".
+ * @param collapseParallel Whether to keep only the lightest of parallel edges.
  */
-void Server::solveMSTWithPipeline(int client_socket, MSTAlgorithmType algoType, const std::string algorithm)
+void Server::importGraph(int client_id, const std::string &path, const std::string &format, bool collapseParallel)
 {
-    std::lock_guard<std::mutex> graphLock(graph_mutex);
-    std::lock_guard<std::mutex> resultsLock(mstResultsMutex);
-    std::lock_guard<std::mutex> tasksLock(clientTasksMutex);
+    // Parse the text file on several threads before taking the lock, then install the new graph
+    std::string error;
+    auto graph = ::importGraph(path, stringToGraphFormat(format), error, 0, collapseParallel);
+    if (!graph)
+    {
+        safePrint("Failed to import graph for client " + std::to_string(client_id) + ": " + error);
+        return;
+    }
 
-    safePrint("**solveMSTWithPipeline:**\n");
+    int vertices = graph->getVertexCount();
+    size_t edges = graph->getEdges().size();
+    {
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        clientGraphs[client_id] = std::move(graph);
+        maintainedMSTs.erase(client_id);
+        graphPins.erase(client_id);
+    }
+    safePrint("Imported " + format + " graph " + path + " with " + std::to_string(vertices) + " vertices and " + std::to_string(edges) + " edges for client " + std::to_string(client_id));
+}
 
-    if (clientGraphs.find(client_socket) == clientGraphs.end())
+/**
+ * @brief Replaces the client's graph with a memory-mapped graph file.
+ * @param client_id The client ID.
+ * @param path Path of the graph file.
+ */
+void Server::loadGraph(int client_id, const std::string &path)
+{
+    // Map and validate the file before taking the lock; attaching it is then O(1)
+    std::string error;
+    auto file = MappedGraphFile::open(path, error);
+    if (!file)
     {
-        safePrint("No graph found for client " + std::to_string(client_socket));
+        safePrint("Failed to load graph for client " + std::to_string(client_id) + ": " + error);
         return;
     }
 
-    mstResults[client_socket] = MSTResult();
-    clientTasks.erase(client_socket);
-
-    MSTFactory factory;
-    auto solver = factory.createSolver(algoType);
+    int vertices = file->vertexCount();
+    size_t edges = file->edges().size();
+    {
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        clientGraphs[client_id] = std::make_shared<Graph>(Graph::fromMappedFile(std::move(file)));
+        maintainedMSTs.erase(client_id);
+        graphPins.erase(client_id);
+    }
+    safePrint("Loaded graph " + path + " with " + std::to_string(vertices) + " vertices and " + std::to_string(edges) + " edges for client " + std::to_string(client_id));
+}
 
-    if (solver)
+/**
+ * @brief Writes the client's graph as a graph file.
+ * @param client_id The client ID.
+ * @param path Path of the graph file.
+ */
+void Server::saveGraph(int client_id, const std::string &path)
+{
+    // Pin the current version and write it without holding the lock
+    std::shared_ptr<const Graph> graph;
     {
-        std::lock_guard<std::mutex> clientLock(clientMutexes[client_socket]);
+        std::lock_guard<std::mutex> lock(graph_mutex);
+        graph = pinGraph(client_id);
+    }
+    std::string error;
+    if (graph && graph->save(path, error))
+        safePrint("Saved graph of client " + std::to_string(client_id) + " to " + path);
+    else
+        safePrint("Failed to save graph of client " + std::to_string(client_id) + ": " + error);
+    releaseGraph(client_id, graph);
+}
 
-        auto mst = solver->computeMST(clientGraphs[client_socket].getEdges(), clientGraphs[client_socket].getVertexCount());
-        mstResults[client_socket] = mst;
+/**
+ * @brief Solves the MST and processes the result using the PAO pipeline.
+ * @param client_socket The client's socket file descriptor.
+ * @param algoType The MST algorithm to use.
+ * @param algorithm The name of the algorithm.
+ * @param ordering Vertex relabeling applied before solving, VertexOrdering::None to solve the graph as is.
+ * @param metrics The metrics to compute besides the total weight.
+ */
+void Server::solveMSTWithPipeline(int client_socket, MSTAlgorithmType algoType, const std::string algorithm, VertexOrdering ordering,
+                                  MSTMetrics metrics)
+{
+    safePrint("**solveMSTWithPipeline:**\n");
 
-        safePrint("MST computed successfully for client " + std::to_string(client_socket));
+    // Pin the current version of the graph. Edits made meanwhile copy it instead of modifying it,
+    // so the solve below runs without holding graph_mutex or the result locks. A result cached for
+    // this version, algorithm and metrics selection is sent as is; otherwise, if the graph was only edited since the
+    // last solve, its maintained MST is measured instead of solving the graph again.
+    std::shared_ptr<const Graph> graph;
+    std::mutex *clientMutex;
+    std::shared_ptr<const MSTResult> result;
+    EdgeList maintainedEdges;
+    bool maintained = false;
+    {
+        std::lock_guard<std::mutex> graphLock(graph_mutex);
+        graph = pinGraph(client_socket);
+        if (!graph)
+        {
+            safePrint("No graph found for client " + std::to_string(client_socket));
+            return;
+        }
+        clientMutex = &clientMutexes[client_socket];
+        result = resultCache.find(client_socket, graph->getVersion(), algoType, metrics);
 
-        auto task = std::make_unique<Triple>(Triple{&mstResults[client_socket], "MST created using " + algorithm + " algorithm.\n", client_socket});
+        auto found = maintainedMSTs.find(client_socket);
+        if (!result && found != maintainedMSTs.end())
+        {
+            maintained = true;
+            maintainedEdges = found->second->edges();
+        }
+    }
 
-        clientTasks[client_socket] = std::move(task);
-        pao->enqueueTask(static_cast<void *>(clientTasks[client_socket].get()));
+    if (algoType == MSTAlgorithmType::Invalid || ordering == VertexOrdering::Invalid)
+    {
+        safePrint("Failed to create solver for " + algorithm + " algorithm.");
+        releaseGraph(client_socket, graph);
+        return;
+    }
+
+    std::lock_guard<std::mutex> clientLock(*clientMutex); // Serializes the solves of one client
 
-        safePrint("Added MST task to pipeline for client " + std::to_string(client_socket));
+    if (result)
+    {
+        safePrint("Reusing the cached MST of client " + std::to_string(client_socket));
+    }
+    else if (maintained)
+    {
+        result = std::make_shared<const MSTResult>(MSTFactory::measure(std::move(maintainedEdges), graph->getVertexCount(), metrics));
+        resultCache.insert(client_socket, graph->getVersion(), algoType, metrics, result);
+        safePrint("Reusing the MST maintained across graph edits for client " + std::to_string(client_socket));
     }
     else
     {
-        safePrint("Failed to create solver for " + algorithm + " algorithm.");
+        // The algorithm and metrics select one of the compiled solver instantiations, kept per thread
+        // with its buffers from earlier solves
+        MSTAlgorithmType solverType = MSTFactory::resolve(algoType, *graph);
+        safePrint("Solving the MST of client " + std::to_string(client_socket) + " with " + algorithmTypeToString(solverType));
+        result = MSTFactory::solve(solverType, metrics, *graph, ordering);
+        if (!result)
+        {
+            safePrint("Failed to create solver for " + algorithm + " algorithm.");
+            releaseGraph(client_socket, graph);
+            return;
+        }
+        resultCache.insert(client_socket, graph->getVersion(), algoType, metrics, result);
+        safePrint("MST computed successfully for client " + std::to_string(client_socket));
+
+        // Start maintaining this MST, unless the graph was replaced or edited during the solve.
+        // The link-cut tree is built before taking the lock, which only swaps it in; the MST it
+        // replaces, if any, is freed after the lock is released.
+        auto dynamic = std::make_unique<DynamicMST>(graph->getVertexCount(), result->mstEdges);
+        std::lock_guard<std::mutex> graphLock(graph_mutex);
+        auto it = clientGraphs.find(client_socket);
+        if (it != clientGraphs.end() && it->second == graph)
+            std::swap(maintainedMSTs[client_socket], dynamic);
     }
+    releaseGraph(client_socket, graph);
+
+    // Only publishing the result needs the result and task maps
+    std::lock_guard<std::mutex> resultsLock(mstResultsMutex);
+    std::lock_guard<std::mutex> tasksLock(clientTasksMutex);
+
+    mstResults[client_socket] = result;
+    auto task = std::make_unique<Triple>(Triple{result.get(), "MST created using " + algorithm + " algorithm.\n", client_socket, metrics});
+
+    clientTasks[client_socket] = std::move(task);
+    pao->enqueueTask(static_cast<void *>(clientTasks[client_socket].get()));
+
+    safePrint("Added MST task to pipeline for client " + std::to_string(client_socket));
 }
 
 /**
@@ -1,28 +1,35 @@
 // Tree.hpp
 #pragma once
 #include <vector>
-#include <tuple>
 #include <unordered_map>
+#include "EdgeList.hpp"
+#include "MSTResult.hpp"
 
 class Tree {
 private:
-    std::vector<std::tuple<int, int, int, int>> mstEdges;
-    std::unordered_map<int, std::unordered_map<int, int>> shortestPathMatrix;
+    EdgeList mstEdges;
+    bool allPairs; // Whether shortestPathMatrix was computed
+    std::unordered_map<int, std::unordered_map<int, Distance>> shortestPathMatrix;
 
     void calculateAllPairsShortestPaths();
 
 public:
-    Tree(const std::vector<std::tuple<int, int, int, int>> &mst);
+    // With allPairs false the all-pairs distances are skipped: the distance metrics and the matrix
+    // stay empty, and calculateComponents finds the diameters with two sweeps of each tree instead
+    explicit Tree(const EdgeList &mst, bool allPairs = true);
 
-    int calculateTotalWeight() const;
-    int calculateLongestDistance() const;
+    Distance calculateTotalWeight() const;
+    Distance calculateLongestDistance() const;
     double calculateAverageDistance() const;
-    int calculateShortestDistance(int start, int end) const;
+    Distance calculateShortestDistance(int start, int end) const;
+
+    // Splits the forest into its trees; vertices below vertexCount without MST edges are trees of their own
+    std::vector<ComponentStats> calculateComponents(int vertexCount) const;
 
     // Getter for the shortest path matrix
-    const std::unordered_map<int, std::unordered_map<int, int>>& getShortestPathMatrix() const {
+    const std::unordered_map<int, std::unordered_map<int, Distance>>& getShortestPathMatrix() const {
         return shortestPathMatrix;
     }
 
-    // const std::vector<std::tuple<int, int, int, int>>& getMSTEdges() const;
+    const EdgeList& getMSTEdges() const;
 };
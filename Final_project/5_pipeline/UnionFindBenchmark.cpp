@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "union_find.hpp"
+
+// A sequence of unite calls, in the order a Kruskal-style solver would make them
+struct Workload
+{
+    std::string name;
+    int vertices;
+    std::vector<std::pair<int, int>> edges;
+};
+
+// Random graph with the edges in random order, as Kruskal sees them after sorting random weights
+static Workload randomWorkload(const std::string &name, int vertices, long long edges, std::mt19937 &random)
+{
+    Workload workload{name, vertices, {}};
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    workload.edges.reserve(edges);
+    for (long long e = 0; e < edges; ++e)
+        workload.edges.push_back({vertex(random), vertex(random)});
+    return workload;
+}
+
+// Square grid, like a road network, with the edges in random order
+static Workload gridWorkload(int vertices, std::mt19937 &random)
+{
+    int side = std::max(2, static_cast<int>(std::sqrt(vertices)));
+    Workload workload{"grid", side * side, {}};
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c)
+        {
+            if (c + 1 < side)
+                workload.edges.push_back({r * side + c, r * side + c + 1});
+            if (r + 1 < side)
+                workload.edges.push_back({r * side + c, (r + 1) * side + c});
+        }
+    std::shuffle(workload.edges.begin(), workload.edges.end(), random);
+    return workload;
+}
+
+// A path united from one end, which builds deep trees unless the linking keeps them shallow
+static Workload chainWorkload(int vertices)
+{
+    Workload workload{"chain", vertices, {}};
+    for (int v = 1; v < vertices; ++v)
+        workload.edges.push_back({v, v - 1});
+    return workload;
+}
+
+// Best of 'repeats' runs of the whole workload, in milliseconds
+template <typename Link, typename Compaction, bool Packed>
+static void timeUnionFind(const Workload &workload, int repeats, const std::string &label)
+{
+    double best = 0;
+    int merged = 0;
+    for (int run = 0; run < repeats; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        BasicUnionFind<Link, Compaction, Packed> uf(workload.vertices);
+        merged = 0;
+        for (auto [u, v] : workload.edges)
+            merged += uf.unite(u, v);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 ? ms : std::min(best, ms);
+    }
+    std::cout << "  " << std::left << std::setw(28) << label << best << " ms, " << merged << " merges" << std::endl;
+}
+
+template <typename Link, typename Compaction>
+static void timeLayouts(const Workload &workload, int repeats, const std::string &label)
+{
+    timeUnionFind<Link, Compaction, false>(workload, repeats, label);
+    timeUnionFind<Link, Compaction, true>(workload, repeats, label + " packed");
+}
+
+template <typename Link>
+static void timeCompactions(const Workload &workload, int repeats, const std::string &label)
+{
+    timeLayouts<Link, FullCompression>(workload, repeats, label + " full");
+    timeLayouts<Link, PathHalving>(workload, repeats, label + " halving");
+    timeLayouts<Link, PathSplitting>(workload, repeats, label + " splitting");
+}
+
+// Times every link, compaction and layout combination of BasicUnionFind on the graph shapes
+// our solvers meet: sparse and dense random graphs, grids, and a worst case chain.
+// Usage: uf_benchmark [vertices] [repeats]   (default: 1000000 vertices, 3 runs)
+int main(int argc, char *argv[])
+{
+    int vertices = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int repeats = argc > 2 ? std::stoi(argv[2]) : 3;
+    if (vertices < 64 || repeats < 1)
+    {
+        std::cerr << "Usage: " << argv[0] << " [vertices >= 64] [repeats >= 1]" << std::endl;
+        return 1;
+    }
+
+    std::mt19937 random(42);
+    std::vector<Workload> workloads;
+    workloads.push_back(randomWorkload("sparse (degree 8)", vertices, 4LL * vertices, random));
+    workloads.push_back(randomWorkload("dense (degree 512)", vertices / 64, 4LL * vertices, random));
+    workloads.push_back(gridWorkload(vertices, random));
+    workloads.push_back(chainWorkload(vertices));
+
+    for (const Workload &workload : workloads)
+    {
+        std::cout << workload.name << ": " << workload.vertices << " vertices, " << workload.edges.size()
+                  << " unites, best of " << repeats << " runs" << std::endl;
+        timeCompactions<LinkByRank>(workload, repeats, "rank");
+        timeCompactions<LinkBySize>(workload, repeats, "size");
+        timeCompactions<LinkRandomized>(workload, repeats, "randomized");
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "VertexOrdering.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    // Appends the component of 'root' to 'order' in breadth-first order.
+    // With byDegree set, the unvisited neighbours of each vertex are visited by increasing degree (Cuthill-McKee).
+    void appendComponent(const AdjacencyView &adj, int root, bool byDegree,
+                         std::vector<VertexId> &order, std::vector<bool> &visited)
+    {
+        std::size_t head = order.size();
+        order.push_back(static_cast<VertexId>(root));
+        visited[root] = true;
+        while (head < order.size())
+        {
+            int v = order[head++];
+            std::size_t first = order.size();
+            for (int k = adj.offsets[v]; k < adj.offsets[v + 1]; ++k)
+            {
+                int to = adj.targets[k];
+                if (!visited[to])
+                {
+                    visited[to] = true;
+                    order.push_back(adj.targets[k]);
+                }
+            }
+            if (byDegree)
+                std::stable_sort(order.begin() + first, order.end(), [&adj](VertexId a, VertexId b)
+                                 { return adj.degree(a) < adj.degree(b); });
+        }
+    }
+
+    // Lowest degree vertex of the component of 'v', a cheap stand-in for a peripheral vertex
+    int minDegreeVertex(const AdjacencyView &adj, int v, std::vector<bool> &visited, std::vector<VertexId> &scratch)
+    {
+        scratch.clear();
+        appendComponent(adj, v, false, scratch, visited);
+        int best = v;
+        for (VertexId u : scratch)
+        {
+            visited[u] = false;
+            if (adj.degree(u) < adj.degree(best))
+                best = u;
+        }
+        return best;
+    }
+}
+
+std::vector<VertexId> computeVertexOrder(const AdjacencyView &adj, VertexOrdering ordering)
+{
+    int vertexCount = adj.vertexCount();
+    std::vector<VertexId> order;
+    order.reserve(vertexCount);
+    if (ordering != VertexOrdering::Bfs && ordering != VertexOrdering::ReverseCuthillMcKee)
+    {
+        order.resize(vertexCount);
+        std::iota(order.begin(), order.end(), VertexId(0));
+        return order;
+    }
+
+    bool rcm = ordering == VertexOrdering::ReverseCuthillMcKee;
+    std::vector<bool> visited(vertexCount, false);
+    std::vector<VertexId> scratch;
+    for (int v = 0; v < vertexCount; ++v)
+    {
+        if (visited[v])
+            continue;
+        std::size_t first = order.size();
+        appendComponent(adj, rcm ? minDegreeVertex(adj, v, visited, scratch) : v, rcm, order, visited);
+        if (rcm)
+            std::reverse(order.begin() + first, order.end());
+    }
+    return order;
+}
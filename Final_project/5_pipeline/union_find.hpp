@@ -1,18 +1,206 @@
 #ifndef UNION_FIND_H
 #define UNION_FIND_H
 
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-// Implementation of Union Find (Disjoint Set Union)
-// Code includes Path Compression and Union by Rank for speeding it up
-// Complexity: unite -> O( inverse_ack(n) ), find_parent( inverse_ack(n) )
-struct UnionFind
+// Implementation of Union Find (Disjoint Set Union), as a template over two policies:
+//  - Link decides which of two roots becomes the parent of the other: LinkByRank, LinkBySize or LinkRandomized
+//  - Compaction decides how find shortens the path it walks: FullCompression, PathHalving or PathSplitting
+// With Packed set, the parent and the rank (or size) of a node share one 32-bit word: a node
+// stores its parent, a root stores ~rank, so every find touches a single array.
+// Any link policy with any compaction gives unite -> O( inverse_ack(n) ), find_parent( inverse_ack(n) ),
+// amortized (expected for LinkRandomized). uf_benchmark compares the combinations on our graph shapes.
+
+// Linking order of LinkRandomized: a bit mix of the index (the finalizer of MurmurHash3).
+// It is a bijection, so two different roots never tie.
+inline std::uint32_t linkPriority(int v)
+{
+	std::uint32_t h = static_cast<std::uint32_t>(v);
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+	return h;
+}
+
+// Parent array, plus the rank or size of every root in a second array
+class SplitNodes
+{
+public:
+	SplitNodes(int n, int rootValue) : parents(n), values(n, rootValue)
+	{
+		std::iota(parents.begin(), parents.end(), 0);
+	}
+	// Makes n singletons again, keeping the arrays' capacity
+	void reset(int n, int rootValue)
+	{
+		parents.resize(n);
+		std::iota(parents.begin(), parents.end(), 0);
+		values.assign(n, rootValue);
+	}
+	int parent(int v) const { return parents[v]; }
+	void setParent(int v, int p) { parents[v] = p; }
+	int value(int root) const { return values[root]; }
+	void setValue(int root, int value) { values[root] = value; }
+
+private:
+	std::vector<int> parents, values;
+};
+
+// One word per node: the parent of a node, or ~value (always negative) for a root
+class PackedNodes
+{
+public:
+	PackedNodes(int n, int rootValue) : words(n, ~rootValue) {}
+	void reset(int n, int rootValue) { words.assign(n, ~rootValue); }
+	int parent(int v) const { return words[v] < 0 ? v : words[v]; }
+	void setParent(int v, int p) { words[v] = p; }
+	int value(int root) const { return ~words[root]; }
+	void setValue(int root, int value) { words[root] = ~value; }
+
+private:
+	std::vector<std::int32_t> words;
+};
+
+// Link policies. link(nodes, x, y) joins two different roots and returns the new root.
+struct LinkByRank
+{
+	static constexpr int ROOT_VALUE = 0;
+	template <typename Nodes>
+	static int link(Nodes &nodes, int x, int y)
+	{
+		if (nodes.value(x) < nodes.value(y)) std::swap(x, y);
+		if (nodes.value(x) == nodes.value(y)) nodes.setValue(x, nodes.value(x) + 1);
+		nodes.setParent(y, x);
+		return x;
+	}
+};
+
+struct LinkBySize
+{
+	static constexpr int ROOT_VALUE = 1;
+	template <typename Nodes>
+	static int link(Nodes &nodes, int x, int y)
+	{
+		if (nodes.value(x) < nodes.value(y)) std::swap(x, y);
+		nodes.setValue(x, nodes.value(x) + nodes.value(y));
+		nodes.setParent(y, x);
+		return x;
+	}
+};
+
+struct LinkRandomized
+{
+	static constexpr int ROOT_VALUE = 0; // Unused, the priority is computed from the index
+	template <typename Nodes>
+	static int link(Nodes &nodes, int x, int y)
+	{
+		if (linkPriority(x) < linkPriority(y)) std::swap(x, y);
+		nodes.setParent(y, x);
+		return x;
+	}
+};
+
+// Compaction policies. find(nodes, x) returns the root of x and shortens the path on the way.
+// All of them are iterative, so deep paths can't overflow the stack.
+
+// Points every node on the path straight at the root, in a second pass
+struct FullCompression
+{
+	template <typename Nodes>
+	static int find(Nodes &nodes, int x)
+	{
+		int root = x;
+		while (nodes.parent(root) != root) root = nodes.parent(root);
+		while (x != root)
+		{
+			int next = nodes.parent(x);
+			nodes.setParent(x, root);
+			x = next;
+		}
+		return root;
+	}
+};
+
+// Points every other node on the path at its grandparent, in a single pass
+struct PathHalving
 {
-	UnionFind(int _n);
-	int find_parent(int node);
-	bool unite(int x, int y);
-	std::vector<int> parent, rank;
+	template <typename Nodes>
+	static int find(Nodes &nodes, int x)
+	{
+		while (nodes.parent(x) != x)
+		{
+			int grandparent = nodes.parent(nodes.parent(x));
+			nodes.setParent(x, grandparent);
+			x = grandparent;
+		}
+		return x;
+	}
+};
+
+// Points every node on the path at its grandparent, in a single pass
+struct PathSplitting
+{
+	template <typename Nodes>
+	static int find(Nodes &nodes, int x)
+	{
+		while (nodes.parent(x) != x)
+		{
+			int next = nodes.parent(x);
+			nodes.setParent(x, nodes.parent(next));
+			x = next;
+		}
+		return x;
+	}
+};
+
+template <typename Link = LinkByRank, typename Compaction = FullCompression, bool Packed = false>
+struct BasicUnionFind
+{
+	using Nodes = std::conditional_t<Packed, PackedNodes, SplitNodes>;
+
+	BasicUnionFind(int _n) : nodes(_n, Link::ROOT_VALUE), n(_n), cc(_n) {}
+
+	// Starts over with _n singletons. Allocates only when _n exceeds every earlier size,
+	// so a solver can keep one union-find across solves.
+	void reset(int _n)
+	{
+		nodes.reset(_n, Link::ROOT_VALUE);
+		n = cc = _n;
+	}
+
+	int find_parent(int node) { return Compaction::find(nodes, node); }
+
+	// Read-only find without path compression, safe to call from several threads
+	int find_root(int node) const
+	{
+		while (nodes.parent(node) != node) node = nodes.parent(node);
+		return node;
+	}
+
+	bool unite(int x, int y)
+	{
+		x = find_parent(x);
+		y = find_parent(y);
+		if (x == y) return false;
+		Link::link(nodes, x, y);
+		--cc;
+		return true;
+	}
+
+	Nodes nodes;
 	int n, cc;
 };
 
-#endif
\ No newline at end of file
+// The classic combination: union by rank with full path compression
+using UnionFind = BasicUnionFind<>;
+
+// Fastest combination in uf_benchmark on sparse random graphs and grids, where Kruskal spends its time
+using SparseUnionFind = BasicUnionFind<LinkBySize, PathHalving, true>;
+
+#endif